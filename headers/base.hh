@@ -8,10 +8,15 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <utility>
+#include <cstdint>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 using namespace std;
 
-void repl_print(const string& s);
+struct Object;
+void repl_print(Object* v);
 
 template<typename TO, typename FROM>
 unique_ptr<TO> static_unique_ptr_cast (unique_ptr<FROM>&& old) {
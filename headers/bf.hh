@@ -2,32 +2,362 @@
 #define BUILTIN_HH
 
 #include "node.hh"
+#include "io.hh"
+#include "par.hh"
+#include <climits>
 
 // --------------------------------
+// native binding: def("name", f) binds a C++ function (or captureless
+// lambda) as a builtin. BfArg/BfRet map C++ parameter and return types
+// onto objects; bf_thunk is instantiated per signature and does the type
+// checks and argument unpacking at the call site, without allocating.
 
-struct Len: BuiltIn {
-	Len(): BuiltIn("len", make_shared<ArgWrapper>(vector<string*>{ new string("x") })) { btype = BfType::LEN; }
+template<typename T> struct BfArg;
 
-	unique_ptr<Object> code(vector<unique_ptr<Object>> exps) const override {
-		unique_ptr<Object> x = move(exps[0]);
-		if (x->otype != ObjType::STR)
-			return make_unique<Error>(ErrorType::TYPE, "bf::" + id + "() expects a string");
+template<> struct BfArg<int64_t> {
+	static const char* name() { return "int"; }
+	static bool check(Object* o) { return o->otype == ObjType::INT; }
+	static int64_t get(Object* o) { return obj_vcast<int64_t>(o); }
+};
+
+// values outside int fail the check rather than being narrowed
+template<> struct BfArg<int> {
+	static const char* name() { return "int"; }
+	static bool check(Object* o) {
+		if (o->otype != ObjType::INT) return false;
+		int64_t v = obj_vcast<int64_t>(o);
+		return v >= INT_MIN && v <= INT_MAX;
+	}
+	static int get(Object* o) { return obj_vcast<int64_t>(o); }
+};
+
+template<> struct BfArg<double> {
+	static const char* name() { return "double"; }
+	static bool check(Object* o) { return o->otype == ObjType::FLT; }
+	static double get(Object* o) { return obj_vcast<double>(o); }
+};
+
+template<> struct BfArg<bool> {
+	static const char* name() { return "bool"; }
+	static bool check(Object* o) { return o->otype == ObjType::BOOL; }
+	static bool get(Object* o) { return obj_vcast<bool>(o); }
+};
+
+template<> struct BfArg<string> {
+	static const char* name() { return "string"; }
+	static bool check(Object* o) { return o->otype == ObjType::STR; }
+	static const string& get(Object* o) { return *(string*)o->value; }
+};
+
+template<> struct BfArg<Object*> {
+	static const char* name() { return "any"; }
+	static bool check(Object* o) { return true; }
+	static Object* get(Object* o) { return o; }
+};
+
+template<> struct BfArg<Gen*> {
+	static const char* name() { return "generator"; }
+	static bool check(Object* o) { return o->otype == ObjType::GEN; }
+	static Gen* get(Object* o) { return (Gen*)o; }
+};
+
+template<typename T> struct BfRet;
+
+template<> struct BfRet<int64_t> { static unique_ptr<Object> wrap(int64_t v) { return make_unique<Int>(v); } };
+template<> struct BfRet<int> { static unique_ptr<Object> wrap(int v) { return make_unique<Int>(v); } };
+template<> struct BfRet<double> { static unique_ptr<Object> wrap(double v) { return make_unique<Double>(v); } };
+template<> struct BfRet<bool> { static unique_ptr<Object> wrap(bool v) { return make_unique<Bool>(v); } };
+template<> struct BfRet<string> { static unique_ptr<Object> wrap(const string& v) { return make_unique<String>(v); } };
+template<> struct BfRet<unique_ptr<Object>> { static unique_ptr<Object> wrap(unique_ptr<Object> v) { return v; } };
+
+template<typename R, typename... A>
+struct BfCall {
+	template<size_t... I>
+	static unique_ptr<Object> run(R (*f)(A...), Object** argv, index_sequence<I...>) {
+		return BfRet<R>::wrap(f(BfArg<decay_t<A>>::get(argv[I])...));
+	}
+};
+
+template<typename... A>
+struct BfCall<void, A...> {
+	template<size_t... I>
+	static unique_ptr<Object> run(void (*f)(A...), Object** argv, index_sequence<I...>) {
+		f(BfArg<decay_t<A>>::get(argv[I])...);
+		return make_unique<Null>();
+	}
+};
+
+// index of the first argument failing its type check, 0 if all pass
+template<typename... A, size_t... I>
+size_t bf_check(Object** argv, index_sequence<I...>) {
+	const bool ok[] = { true, BfArg<decay_t<A>>::check(argv[I])... };
+	for (size_t i = 1; i <= sizeof...(A); i++)
+		if (!ok[i]) return i;
+	return 0;
+}
+
+template<typename R, typename... A>
+unique_ptr<Object> bf_thunk(BfPtr fn, Object** argv, const string& id) {
+	if (size_t i = bf_check<A...>(argv, index_sequence_for<A...>())) {
+		const char* names[] = { "", BfArg<decay_t<A>>::name()... };
+		return make_unique<Error>(ErrorType::TYPE, "bf::" + id + "() expects " + names[i] + " as argument " + to_string(i));
+	}
+	return BfCall<R, A...>::run((R (*)(A...))fn, argv, index_sequence_for<A...>());
+}
+
+template<typename R, typename... A>
+void def(const string& name, R (*f)(A...)) {
+	static_assert(sizeof...(A) <= BF_MAX_ARGS, "def(): too many parameters");
+	const char* names[] = { "", BfArg<decay_t<A>>::name()... };
+	string sig;
+	for (size_t i = 1; i <= sizeof...(A); i++) sig += (i > 1 ? "," : "") + string(names[i]);
+	env_stack->create(name, make_unique<BuiltIn>(name, sig, (BfPtr)f, &bf_thunk<R, A...>, sizeof...(A)));
+}
+
+// captureless lambdas decay to a plain function pointer
+template<typename F>
+void def(const string& name, F f) { def(name, +f); }
+
+// --------------------------------
+
+inline int64_t bf_len(const string& x) {
+	return x.size();
+}
+
+inline unique_ptr<Object> bf_type(Object* x) {
+	return make_unique<String>(objtype_str[x->otype], false);
+}
+
+// out is not thread safe, and output from pmap workers would come out
+// in no particular order anyway
+inline unique_ptr<Object> worker_io(const string& id) {
+	return make_unique<Error>(ErrorType::UNSOP, "bf::" + id + "() cannot run inside pmap or preduce");
+}
+
+// strings are written without quotes
+inline void bf_write(Object* x) {
+	if (x->otype == ObjType::STR) out.write(*(string*)x->value);
+	else x->put(out);
+}
+
+// print(x) writes x and a newline, puts(x) only x
+inline unique_ptr<Object> bf_print(Object* x) {
+	if (par_worker) return worker_io("print");
+	bf_write(x);
+	out.newline();
+	return make_unique<Null>();
+}
+
+inline unique_ptr<Object> bf_puts(Object* x) {
+	if (par_worker) return worker_io("puts");
+	bf_write(x);
+	return make_unique<Null>();
+}
+
+inline unique_ptr<Object> bf_flush() {
+	if (par_worker) return worker_io("flush");
+	out.flush();
+	return make_unique<Null>();
+}
+
+// --------------------------------
+// lazy sequences: range is a source, map/filter/take wrap another
+// sequence, next and reduce pull values through
+
+inline bool callable(Object* f) {
+	return f->otype == ObjType::FN || f->otype == ObjType::BF;
+}
+
+struct RangeGen : GenState {
+	int64_t cur, end;
+
+	RangeGen(int64_t a, int64_t b): cur(a), end(b) {}
+	unique_ptr<Object> next() override {
+		if (cur >= end) return nullptr;
+		return make_unique<Int>(cur++);
+	}
+};
+
+struct MapGen : GenState {
+	unique_ptr<Object> f;
+	shared_ptr<GenState> src;
 
-		return make_unique<Int>(obj_vcast<string>(x.get()).size());
+	MapGen(unique_ptr<Object> f, shared_ptr<GenState> s): f(move(f)), src(s) {}
+	unique_ptr<Object> next() override {
+		unique_ptr<Object> v = src->next();
+		if (v == nullptr) return nullptr;
+		Object* argv[] = { v.get() };
+		return apply(f.get(), argv, 1);
 	}
 };
 
-struct Type: BuiltIn {
-	Type(): BuiltIn("type", make_shared<ArgWrapper>(vector<string*>{ new string("x") })) { btype = BfType::TYPE; }
+struct FilterGen : GenState {
+	unique_ptr<Object> f;
+	shared_ptr<GenState> src;
 
-	unique_ptr<Object> code(vector<unique_ptr<Object>> exps) const override {
-		unique_ptr<Object> x = move(exps[0]);
-		return make_unique<String>(objtype_str[x->otype], false);
+	FilterGen(unique_ptr<Object> f, shared_ptr<GenState> s): f(move(f)), src(s) {}
+	unique_ptr<Object> next() override {
+		while (unique_ptr<Object> v = src->next()) {
+			Object* argv[] = { v.get() };
+			unique_ptr<Object> keep = apply(f.get(), argv, 1);
+			if (keep->otype == ObjType::BOOL && obj_vcast<bool>(keep.get())) return v;
+		}
+		return nullptr;
 	}
 };
 
+struct TakeGen : GenState {
+	shared_ptr<GenState> src;
+	int64_t left;
+
+	TakeGen(shared_ptr<GenState> s, int64_t n): src(s), left(n) {}
+	unique_ptr<Object> next() override {
+		if (left <= 0) return nullptr;
+		left--;
+		return src->next();
+	}
+};
+
+inline unique_ptr<Object> bf_range(int64_t a, int64_t b) {
+	return make_unique<Gen>(make_shared<RangeGen>(a, b));
+}
+
+inline unique_ptr<Object> bf_map(Object* f, Gen* xs) {
+	if (!callable(f)) return make_unique<Error>(ErrorType::TYPE, "bf::map() expects a function");
+	return make_unique<Gen>(make_shared<MapGen>(obj_clone(f), xs->state));
+}
+
+inline unique_ptr<Object> bf_filter(Object* f, Gen* xs) {
+	if (!callable(f)) return make_unique<Error>(ErrorType::TYPE, "bf::filter() expects a function");
+	return make_unique<Gen>(make_shared<FilterGen>(obj_clone(f), xs->state));
+}
+
+inline unique_ptr<Object> bf_take(Gen* xs, int64_t n) {
+	return make_unique<Gen>(make_shared<TakeGen>(xs->state, n));
+}
+
+// the next value, or null once the sequence is exhausted
+inline unique_ptr<Object> bf_next(Gen* xs) {
+	unique_ptr<Object> v = xs->state->next();
+	if (v == nullptr) return make_unique<Null>();
+	return v;
+}
+
+inline unique_ptr<Object> bf_reduce(Object* f, Gen* xs, Object* init) {
+	if (!callable(f)) return make_unique<Error>(ErrorType::TYPE, "bf::reduce() expects a function");
+	unique_ptr<Object> acc = obj_clone(init);
+	while (unique_ptr<Object> v = xs->state->next()) {
+		Object* argv[] = { acc.get(), v.get() };
+		acc = apply(f, argv, 2);
+	}
+	return acc;
+}
+
 // --------------------------------
+// files. read_lines is a lazy sequence, so only the current line is held
+// as an object however large the file is
+
+struct LinesGen : GenState {
+	Reader in;
 
+	unique_ptr<Object> next() override {
+		size_t scanned = 0;
+		while (true) {
+			const char* nl = find_nl(in.p + scanned, in.end);
+			if (nl != in.end) {
+				unique_ptr<Object> line = make_unique<String>(in.p, nl - in.p);
+				in.p = nl + 1;
+				return line;
+			}
+			scanned = in.end - in.p;
+			if (!in.fill()) break;
+		}
 
+		if (!in.err.empty()) {
+			string e = in.err;
+			in.err.clear();
+			return make_unique<Error>(ErrorType::IO, e);
+		}
+		if (in.p == in.end) return nullptr;
+
+		// last line without a trailing newline
+		unique_ptr<Object> line = make_unique<String>(in.p, in.end - in.p);
+		in.p = in.end;
+		return line;
+	}
+};
+
+inline unique_ptr<Object> bf_read_file(const string& path) {
+	string s, err = read_all(path, s);
+	if (!err.empty()) return make_unique<Error>(ErrorType::IO, err);
+	return make_unique<String>(s);
+}
+
+inline unique_ptr<Object> bf_read_lines(const string& path) {
+	shared_ptr<LinesGen> g = make_shared<LinesGen>();
+	if (!g->in.open(path)) return make_unique<Error>(ErrorType::IO, g->in.err);
+	return make_unique<Gen>(g);
+}
+
+inline unique_ptr<Object> bf_write_file(const string& path, const string& s) {
+	if (par_worker) return worker_io("write_file");
+	string err = write_file(path, s);
+	if (!err.empty()) return make_unique<Error>(ErrorType::IO, err);
+	return make_unique<Null>();
+}
+
+// --------------------------------
+// pmap and preduce: map and reduce with f evaluated across the worker
+// pool in par.cc. elements are pulled from the sequence here in batches
+// of PAR_BATCH, so memory stays bounded on long sequences. preduce needs
+// an associative f, since each chunk of a batch is folded separately.
+
+const size_t PAR_BATCH = 1 << 16;
+
+inline vector<unique_ptr<Object>> par_pull(GenState* src) {
+	vector<unique_ptr<Object>> xs;
+	while (xs.size() < PAR_BATCH) {
+		unique_ptr<Object> v = src->next();
+		if (v == nullptr) break;
+		xs.push_back(move(v));
+	}
+	return xs;
+}
+
+struct PMapGen : GenState {
+	unique_ptr<Object> f;
+	shared_ptr<GenState> src;
+	vector<unique_ptr<Object>> buf;
+	size_t at = 0;
+
+	PMapGen(unique_ptr<Object> f, shared_ptr<GenState> s): f(move(f)), src(s) {}
+	unique_ptr<Object> next() override {
+		if (at == buf.size()) {
+			buf = par_map(f.get(), par_pull(src.get()));
+			at = 0;
+			if (buf.empty()) return nullptr;
+		}
+		return move(buf[at++]);
+	}
+};
+
+inline unique_ptr<Object> bf_pmap(Object* f, Gen* xs) {
+	if (!callable(f)) return make_unique<Error>(ErrorType::TYPE, "bf::pmap() expects a function");
+	return make_unique<Gen>(make_shared<PMapGen>(obj_clone(f), xs->state));
+}
+
+inline unique_ptr<Object> bf_preduce(Object* f, Gen* xs, Object* init) {
+	if (!callable(f)) return make_unique<Error>(ErrorType::TYPE, "bf::preduce() expects a function");
+	unique_ptr<Object> acc = obj_clone(init);
+	while (true) {
+		vector<unique_ptr<Object>> batch = par_pull(xs->state.get());
+		if (batch.empty()) break;
+		for (auto& v : par_fold(f, batch)) {
+			Object* argv[] = { acc.get(), v.get() };
+			acc = apply(f, argv, 2);
+		}
+	}
+	return acc;
+}
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,378 @@
+#ifndef BIG_HH
+#define BIG_HH
+
+#include "base.hh"
+
+// arbitrary precision integers, used once Int arithmetic overflows 64 bits.
+// sign and magnitude, the magnitude as little endian 32 bit limbs with no
+// leading zeros (zero has no limbs).
+
+typedef vector<uint32_t> Limbs;
+
+// below this many limbs schoolbook multiplication beats karatsuba
+const size_t KARATSUBA_THRESHOLD = 40;
+
+// largest power of ten that fits a limb, the unit of decimal conversion
+const uint32_t DEC_BASE = 1000000000;
+const int DEC_DIGITS = 9;
+
+// below this many limbs decimal conversion peels off one DEC_BASE digit at
+// a time, and reciprocals come from a plain long division
+const size_t DEC_SPLIT_THRESHOLD = 2048;
+const size_t RECIP_THRESHOLD = 16;
+
+struct Big {
+	bool neg = false;
+	Limbs mag;
+
+	Big() {}
+	Big(int64_t v) {
+		neg = v < 0;
+		uint64_t u = neg ? 0 - (uint64_t)v : (uint64_t)v;
+		while (u) {
+			mag.push_back((uint32_t)u);
+			u >>= 32;
+		}
+	}
+	Big(bool n, Limbs m): neg(n), mag(move(m)) {
+		trim(mag);
+		if (mag.empty()) neg = false;
+	}
+
+	bool zero() const { return mag.empty(); }
+
+	bool fits_i64() const {
+		if (mag.size() <= 1) return true;
+		if (mag.size() > 2) return false;
+		uint64_t u = ((uint64_t)mag[1] << 32) | mag[0];
+		return neg ? u <= (uint64_t)INT64_MAX + 1 : u <= (uint64_t)INT64_MAX;
+	}
+	int64_t to_i64() const {
+		uint64_t u = 0;
+		for (size_t i = mag.size(); i-- > 0;) u = (u << 32) | mag[i];
+		return neg ? (int64_t)(0 - u) : (int64_t)u;
+	}
+
+	// --------------------------------
+	// magnitude helpers
+
+	static void trim(Limbs& a) {
+		while (!a.empty() && a.back() == 0) a.pop_back();
+	}
+
+	static int cmp_mag(const Limbs& a, const Limbs& b) {
+		if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+		for (size_t i = a.size(); i-- > 0;)
+			if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+		return 0;
+	}
+
+	static Limbs add_mag(const Limbs& a, const Limbs& b) {
+		const Limbs& x = a.size() >= b.size() ? a : b;
+		const Limbs& y = a.size() >= b.size() ? b : a;
+		Limbs r(x.size() + 1);
+		uint64_t carry = 0;
+		for (size_t i = 0; i < x.size(); i++) {
+			carry += (uint64_t)x[i] + (i < y.size() ? y[i] : 0);
+			r[i] = (uint32_t)carry;
+			carry >>= 32;
+		}
+		r[x.size()] = (uint32_t)carry;
+		trim(r);
+		return r;
+	}
+
+	// a - b, requires |a| >= |b|
+	static Limbs sub_mag(const Limbs& a, const Limbs& b) {
+		Limbs r(a.size());
+		int64_t borrow = 0;
+		for (size_t i = 0; i < a.size(); i++) {
+			int64_t d = (int64_t)a[i] - (i < b.size() ? b[i] : 0) - borrow;
+			borrow = d < 0;
+			r[i] = (uint32_t)(d + (borrow << 32));
+		}
+		trim(r);
+		return r;
+	}
+
+	// r[off..] += a
+	static void add_at(Limbs& r, const Limbs& a, size_t off) {
+		uint64_t carry = 0;
+		size_t i = 0;
+		for (; i < a.size() || carry; i++) {
+			if (off + i >= r.size()) r.push_back(0);
+			carry += (uint64_t)r[off + i] + (i < a.size() ? a[i] : 0);
+			r[off + i] = (uint32_t)carry;
+			carry >>= 32;
+		}
+	}
+
+	static Limbs mul_school(const Limbs& a, const Limbs& b) {
+		Limbs r(a.size() + b.size());
+		for (size_t i = 0; i < a.size(); i++) {
+			uint64_t carry = 0;
+			for (size_t j = 0; j < b.size(); j++) {
+				carry += (uint64_t)a[i] * b[j] + r[i + j];
+				r[i + j] = (uint32_t)carry;
+				carry >>= 32;
+			}
+			r[i + b.size()] = (uint32_t)carry;
+		}
+		trim(r);
+		return r;
+	}
+
+	static Limbs mul_mag(const Limbs& a, const Limbs& b) {
+		if (a.empty() || b.empty()) return Limbs();
+		if (min(a.size(), b.size()) < KARATSUBA_THRESHOLD) return mul_school(a, b);
+
+		// a = a1*B^m + a0, b = b1*B^m + b0
+		// a*b = z2*B^2m + (z1 - z2 - z0)*B^m + z0, z1 = (a0 + a1)(b0 + b1)
+		size_t m = max(a.size(), b.size()) / 2;
+		auto lo = [m](const Limbs& x) { Limbs r(x.begin(), x.begin() + min(m, x.size())); trim(r); return r; };
+		auto hi = [m](const Limbs& x) { return x.size() > m ? Limbs(x.begin() + m, x.end()) : Limbs(); };
+		Limbs a0 = lo(a), a1 = hi(a), b0 = lo(b), b1 = hi(b);
+
+		Limbs z0 = mul_mag(a0, b0);
+		Limbs z2 = mul_mag(a1, b1);
+		Limbs z1 = sub_mag(sub_mag(mul_mag(add_mag(a0, a1), add_mag(b0, b1)), z0), z2);
+
+		Limbs r(a.size() + b.size());
+		add_at(r, z0, 0);
+		add_at(r, z1, m);
+		add_at(r, z2, 2 * m);
+		trim(r);
+		return r;
+	}
+
+	// a = a * m + c
+	static void mul_small(Limbs& a, uint32_t m, uint32_t c) {
+		uint64_t carry = c;
+		for (auto& l : a) {
+			carry += (uint64_t)l * m;
+			l = (uint32_t)carry;
+			carry >>= 32;
+		}
+		if (carry) a.push_back((uint32_t)carry);
+	}
+
+	// a = a / d, returns a % d
+	static uint32_t div_small(Limbs& a, uint32_t d) {
+		uint64_t rem = 0;
+		for (size_t i = a.size(); i-- > 0;) {
+			uint64_t cur = (rem << 32) | a[i];
+			a[i] = (uint32_t)(cur / d);
+			rem = cur % d;
+		}
+		trim(a);
+		return (uint32_t)rem;
+	}
+
+	// knuth's algorithm D, truncating. requires b non-empty
+	static void divmod_mag(const Limbs& a, const Limbs& b, Limbs& q, Limbs& r) {
+		if (cmp_mag(a, b) < 0) {
+			q.clear();
+			r = a;
+			return;
+		}
+		if (b.size() == 1) {
+			q = a;
+			r.clear();
+			uint32_t rem = div_small(q, b[0]);
+			if (rem) r.push_back(rem);
+			return;
+		}
+
+		// normalize so the top limb of the divisor has its high bit set
+		int s = __builtin_clz(b.back());
+		size_t n = b.size(), m = a.size() - n;
+		Limbs v(n), u(a.size() + 1);
+		for (size_t i = n; i-- > 0;)
+			v[i] = (b[i] << s) | (s && i ? b[i - 1] >> (32 - s) : 0);
+		u[a.size()] = s ? a.back() >> (32 - s) : 0;
+		for (size_t i = a.size(); i-- > 0;)
+			u[i] = (a[i] << s) | (s && i ? a[i - 1] >> (32 - s) : 0);
+
+		q.assign(m + 1, 0);
+		for (size_t j = m + 1; j-- > 0;) {
+			uint64_t num = ((uint64_t)u[j + n] << 32) | u[j + n - 1];
+			uint64_t qhat = num / v[n - 1], rhat = num % v[n - 1];
+			while (qhat >> 32 || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+				qhat--;
+				rhat += v[n - 1];
+				if (rhat >> 32) break;
+			}
+
+			// u[j..j+n] -= qhat * v
+			int64_t borrow = 0;
+			uint64_t carry = 0;
+			for (size_t i = 0; i < n; i++) {
+				carry += qhat * v[i];
+				int64_t t = (int64_t)u[i + j] - borrow - (int64_t)(uint32_t)carry;
+				carry >>= 32;
+				u[i + j] = (uint32_t)t;
+				borrow = t < 0;
+			}
+			int64_t t = (int64_t)u[j + n] - borrow - (int64_t)carry;
+			u[j + n] = (uint32_t)t;
+
+			if (t < 0) {
+				// qhat was one too large, add v back
+				qhat--;
+				uint64_t c = 0;
+				for (size_t i = 0; i < n; i++) {
+					c += (uint64_t)u[i + j] + v[i];
+					u[i + j] = (uint32_t)c;
+					c >>= 32;
+				}
+				u[j + n] += (uint32_t)c;
+			}
+			q[j] = (uint32_t)qhat;
+		}
+		trim(q);
+
+		r.assign(n, 0);
+		for (size_t i = 0; i < n; i++)
+			r[i] = (u[i] >> s) | (s ? (uint32_t)((uint64_t)u[i + 1] << (32 - s)) : 0);
+		trim(r);
+	}
+
+	// a / B^k and a * B^k, B = 2^32
+	static Limbs shr_limbs(const Limbs& a, size_t k) {
+		return k < a.size() ? Limbs(a.begin() + k, a.end()) : Limbs();
+	}
+	static Limbs shl_limbs(const Limbs& a, size_t k) {
+		if (a.empty()) return a;
+		Limbs r(k, 0);
+		r.insert(r.end(), a.begin(), a.end());
+		return r;
+	}
+
+	// about B^2n / d for d of n limbs, a few units off at most. one newton
+	// step x += x * (B^2n - d*x) / B^2n from the reciprocal of the top half
+	// of d (plus guard limbs), so it costs a few multiplications of n limbs
+	static Limbs recip(const Limbs& d) {
+		size_t n = d.size();
+		if (n <= RECIP_THRESHOLD) {
+			Limbs one(2 * n + 1, 0), q, r;
+			one.back() = 1;
+			divmod_mag(one, d, q, r);
+			return q;
+		}
+		size_t h = (n + 1) / 2 + 2;
+		Limbs x = shl_limbs(recip(shr_limbs(d, n - h)), n - h);
+		Big e = Big(false, shl_limbs(Limbs{ 1 }, 2 * n)) - Big(false, mul_mag(d, x));
+		Big c(e.neg, shr_limbs(mul_mag(x, e.mag), 2 * n));
+		return (Big(false, x) + c).mag;
+	}
+
+	// divmod_mag for a < B^2n, d of n limbs and x = recip(d). the quotient
+	// estimate is only off by the error of x, fixed up at the end
+	static void divmod_recip(const Limbs& a, const Limbs& d, const Limbs& x, Limbs& q, Limbs& r) {
+		Big dv(false, d);
+		Big qv(false, shr_limbs(mul_mag(a, x), 2 * d.size()));
+		Big rv = Big(false, a) - qv * dv;
+		for (; rv.neg; rv = rv + dv) qv = qv - Big(1);
+		for (; cmp_mag(rv.mag, d) >= 0; rv = rv - dv) qv = qv + Big(1);
+		q = move(qv.mag);
+		r = move(rv.mag);
+	}
+
+	// --------------------------------
+	// decimal conversion. large values are split by p[k] = DEC_BASE^(2^k)
+	// and both halves converted recursively, so the work is a few
+	// multiplications at each level instead of one division per digit
+
+	// digits of a, zero padded to width
+	static void dec_small(Limbs a, size_t width, string& s) {
+		vector<uint32_t> chunks;
+		while (!a.empty()) chunks.push_back(div_small(a, DEC_BASE));
+
+		string t = chunks.empty() ? "" : to_string(chunks.back());
+		char buf[DEC_DIGITS + 1];
+		for (size_t i = chunks.size() - 1; chunks.size() > 1 && i-- > 0;) {
+			snprintf(buf, sizeof(buf), "%09u", chunks[i]);
+			t += buf;
+		}
+		if (t.size() < width) s.append(width - t.size(), '0');
+		s += t;
+	}
+
+	// digits of a < p[k]^2, zero padded to 2 * DEC_DIGITS * 2^k if pad
+	static void dec(const Limbs& a, const vector<Limbs>& p, const vector<Limbs>& inv, size_t k, bool pad, string& s) {
+		size_t width = pad ? (size_t)DEC_DIGITS << (k + 1) : 0;
+		if (a.size() < DEC_SPLIT_THRESHOLD) return dec_small(a, width, s);
+		if (!pad && cmp_mag(a, p[k]) < 0) return dec(a, p, inv, k - 1, false, s);
+
+		Limbs q, r;
+		if (inv[k].empty()) divmod_mag(a, p[k], q, r);
+		else divmod_recip(a, p[k], inv[k], q, r);
+		dec(q, p, inv, k - 1, pad, s);
+		dec(r, p, inv, k - 1, true, s);
+	}
+
+	// --------------------------------
+
+	static Big parse(const string& s) {
+		Limbs m;
+		size_t i = 0, head = s.size() % DEC_DIGITS;
+		if (head == 0) head = DEC_DIGITS;
+		for (; i < s.size(); head = DEC_DIGITS) {
+			uint32_t chunk = 0;
+			for (size_t k = 0; k < head; k++, i++) chunk = chunk * 10 + (s[i] - '0');
+			mul_small(m, DEC_BASE, chunk);
+		}
+		return Big(false, m);
+	}
+
+	string str() const {
+		if (zero()) return "0";
+		string s = neg ? "-" : "";
+		if (mag.size() < DEC_SPLIT_THRESHOLD) {
+			dec_small(mag, 0, s);
+			return s;
+		}
+
+		// powers up to p[k] with mag < p[k]^2. splits by small powers are
+		// cheap enough as long divisions
+		vector<Limbs> p = { Limbs{ DEC_BASE } }, inv;
+		while (2 * (p.back().size() - 1) < mag.size()) {
+			Limbs sq = mul_mag(p.back(), p.back());
+			if (cmp_mag(sq, mag) > 0) break;
+			p.push_back(move(sq));
+		}
+		for (auto& x : p) inv.push_back(x.size() > RECIP_THRESHOLD ? recip(x) : Limbs());
+		dec(mag, p, inv, p.size() - 1, false, s);
+		return s;
+	}
+
+	int cmp(const Big& o) const {
+		if (neg != o.neg) return neg ? -1 : 1;
+		int c = cmp_mag(mag, o.mag);
+		return neg ? -c : c;
+	}
+
+	Big operator-() const { return Big(!neg, mag); }
+
+	Big operator+(const Big& o) const {
+		if (neg == o.neg) return Big(neg, add_mag(mag, o.mag));
+		if (cmp_mag(mag, o.mag) >= 0) return Big(neg, sub_mag(mag, o.mag));
+		return Big(o.neg, sub_mag(o.mag, mag));
+	}
+	Big operator-(const Big& o) const { return *this + (-o); }
+	Big operator*(const Big& o) const { return Big(neg != o.neg, mul_mag(mag, o.mag)); }
+
+	// truncates toward zero like the builtin int operators. requires o != 0
+	Big operator/(const Big& o) const {
+		Limbs q, r;
+		divmod_mag(mag, o.mag, q, r);
+		return Big(neg != o.neg, q);
+	}
+	Big operator%(const Big& o) const {
+		Limbs q, r;
+		divmod_mag(mag, o.mag, q, r);
+		return Big(neg, r);
+	}
+};
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef IMAGE_HH
+#define IMAGE_HH
+
+#include "base.hh"
+
+// heap images of the global scope, see image.cc
+
+// writes every global except builtins and generators to path.
+// "" on success, otherwise the reason
+string image_save(const string& path);
+
+// binds every value in the image at path in the global scope
+string image_load(const string& path);
+
+#endif
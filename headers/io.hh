@@ -0,0 +1,144 @@
+#ifndef IO_HH
+#define IO_HH
+
+#include "base.hh"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// first '\n' in [p, end), or end. 64 bytes are tested per iteration and
+// only the block holding a hit is looked at byte-wise.
+inline const char* find_nl(const char* p, const char* end) {
+#ifdef __SSE2__
+	const __m128i nl = _mm_set1_epi8('\n');
+	for (; end - p >= 64; p += 64) {
+		__m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl);
+		__m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + 16)), nl);
+		__m128i c = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + 32)), nl);
+		__m128i d = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + 48)), nl);
+		if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)))) break;
+	}
+	for (; end - p >= 16; p += 16) {
+		unsigned m = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+		if (m) return p + __builtin_ctz(m);
+	}
+#endif
+	for (; p < end; p++)
+		if (*p == '\n') return p;
+	return end;
+}
+
+// a file opened for reading. regular files are mapped whole, anything
+// else (pipes, terminals) is read in CHUNK sized pieces. [p, end) is the
+// input not consumed yet, fill() appends to it. err is prefixed by the
+// path, as for every other file error.
+struct Reader {
+	static const size_t CHUNK = 1 << 20;
+
+	int fd = -1;
+	const char* map = nullptr;
+	size_t map_len = 0;
+	vector<char> buf;
+	const char* p = nullptr;
+	const char* end = nullptr;
+	bool eof = false;
+	string path;
+	string err;
+
+	Reader() {}
+	Reader(const Reader&) = delete;
+	~Reader() {
+		if (map != nullptr) munmap((void*)map, map_len);
+		if (fd >= 0) ::close(fd);
+	}
+
+	bool open(const string& file) {
+		path = file;
+		fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			err = path + ": " + strerror(errno);
+			return false;
+		}
+
+		struct stat st;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+			void* m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (m != MAP_FAILED) {
+				madvise(m, st.st_size, MADV_SEQUENTIAL);
+				map = (const char*)m;
+				map_len = st.st_size;
+				p = map;
+				end = map + map_len;
+				eof = true;
+			}
+		}
+		return true;
+	}
+
+	// reads the next chunk, keeping the unconsumed input in front of it.
+	// false once nothing more can be read
+	bool fill() {
+		if (eof) return false;
+
+		size_t keep = end - p;
+		if (keep) memmove(buf.data(), p, keep);
+		if (buf.size() < keep + CHUNK) buf.resize(keep + CHUNK);
+
+		ssize_t n;
+		do n = ::read(fd, buf.data() + keep, buf.size() - keep);
+		while (n < 0 && errno == EINTR);
+		if (n < 0) err = path + ": " + strerror(errno);
+
+		p = buf.data();
+		end = p + keep + (n > 0 ? n : 0);
+		if (n <= 0) eof = true;
+		return n > 0;
+	}
+};
+
+// the whole file at path into s. "" on success, otherwise the reason
+inline string read_all(const string& path, string& s) {
+	Reader in;
+	if (!in.open(path)) return in.err;
+	if (in.map != nullptr) {
+		s.assign(in.map, in.map_len);
+		return "";
+	}
+
+	s.clear();
+	while (in.fill()) {
+		s.append(in.p, in.end);
+		in.p = in.end;
+	}
+	return in.err;
+}
+
+// "" on success, otherwise the reason
+inline string write_file(const string& path, const string& s) {
+	int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) return path + ": " + strerror(errno);
+
+	const char* p = s.data();
+	size_t n = s.size();
+	while (n) {
+		ssize_t w = ::write(fd, p, n);
+		if (w < 0 && errno == EINTR) continue;
+		if (w <= 0) {
+			string e = path + ": " + strerror(errno);
+			::close(fd);
+			return e;
+		}
+		p += w;
+		n -= w;
+	}
+	if (::close(fd) < 0) return path + ": " + strerror(errno);
+	return "";
+}
+
+#endif
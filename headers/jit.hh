@@ -0,0 +1,27 @@
+#ifndef JIT_HH
+#define JIT_HH
+
+#include "obj.hh"
+
+// baseline JIT for hot numeric functions, see jit.cc
+
+struct Fn;
+
+const size_t JIT_MAX_ARGS = 6;
+
+extern bool jit_enabled;
+extern size_t jit_threshold;
+
+// set on pmap/preduce worker threads, which share compiled code
+extern thread_local bool jit_worker;
+
+// runs fn natively on the already evaluated argv if it is (or just became)
+// compiled for these argument types. nullptr means the call was declined
+// or deoptimized, and the caller interprets the body instead.
+unique_ptr<Object> jit_call(Fn* fn, Object** argv, size_t argc);
+
+// drops this worker's view of compiled code, which the main thread may
+// have freed since
+void jit_forget();
+
+#endif
@@ -2,12 +2,13 @@
 #define NODE_HH
 
 #include "scope.hh"
+#include "jit.hh"
 
 enum class PrefixOp;
 enum class InfixOp;
 
 extern bool repl;
-extern EnvStack* env_stack;
+extern thread_local EnvStack* env_stack;
 extern unordered_map<ObjType,string> objtype_str;
 extern unordered_map<PrefixOp,string> prefix_str;
 extern unordered_map<InfixOp,string> infix_str;
@@ -26,6 +27,7 @@ enum class StmtType {
 	RETURN,
 	IF,
 	EXP,
+	YIELD,
 };
 
 enum class ExpType {
@@ -66,11 +68,6 @@ enum class InfixOp {
 	OR,
 };
 
-enum class BfType {
-	LEN, 
-	TYPE
-};
-
 struct Node {
 	NodeType ntype;
 };
@@ -79,11 +76,13 @@ struct Node {
 
 struct Statement: Node {
 	StmtType stype;
+	virtual ~Statement() {}
 	virtual void code() = 0;
 };
 
 struct Expression: Node {
 	ExpType etype;
+	virtual ~Expression() {}
 	virtual unique_ptr<Object> code() = 0;
 };
 
@@ -138,11 +137,14 @@ struct ExpWrapper {
 
 // --------------------------------
 
+inline bool has_yield(StmtWrapper* s);
+
 struct BlockStmt: Node {
 	StmtWrapper *stmt_list;
+	bool generator;
 
-	BlockStmt(const BlockStmt& b): stmt_list(b.stmt_list) { ntype = NodeType::BLOCK; }
-	BlockStmt(StmtWrapper *s): stmt_list(s) { ntype = NodeType::BLOCK; }
+	BlockStmt(const BlockStmt& b): stmt_list(b.stmt_list), generator(b.generator) { ntype = NodeType::BLOCK; }
+	BlockStmt(StmtWrapper *s): stmt_list(s), generator(has_yield(s)) { ntype = NodeType::BLOCK; }
 	~BlockStmt() { delete stmt_list; }
 	void code() {
 		env_stack->push_scope();
@@ -155,7 +157,7 @@ struct BlockStmt: Node {
 struct Program: Node {
 	StmtWrapper *stmt_list;
 
-	Program() { ntype = NodeType::PROG; }
+	Program(): stmt_list(nullptr) { ntype = NodeType::PROG; }
 	Program(StmtWrapper *s): stmt_list(s) { ntype = NodeType::PROG; }
 	~Program() { delete stmt_list; }
 	void code() {
@@ -182,21 +184,25 @@ struct Fn: Object {
 	}
 };
 
+// builtins are plain C++ functions registered through def() in bf.hh.
+// fn is the type-erased function pointer and thunk the template-generated
+// wrapper that type checks the arguments in place and calls it.
+typedef void (*BfPtr)();
+typedef unique_ptr<Object> (*BfThunk)(BfPtr fn, Object** argv, const string& id);
+const size_t BF_MAX_ARGS = 8;
+
 struct BuiltIn : Object {
 	string id;
-	BfType btype;
-	shared_ptr<ArgWrapper> args;
+	string sig;
+	BfPtr fn;
+	BfThunk thunk;
+	size_t arity;
 
-	BuiltIn(const string& name, shared_ptr<ArgWrapper> args): id(name), args(args) { otype = ObjType::BF; }
+	BuiltIn(const string& name, const string& sig, BfPtr f, BfThunk t, size_t n): id(name), sig(sig), fn(f), thunk(t), arity(n) { otype = ObjType::BF; }
 
 	string str() const override {
-		string s = "bf::" + id + "("; 
-		for (auto& arg : args->args) s += *arg + ",";
-		s += ")";
-		return s;
+		return "bf::" + id + "(" + sig + ")";
 	}
-
-	virtual unique_ptr<Object> code(vector<unique_ptr<Object>> exps) const = 0;
 };
 
 // --------------------------------
@@ -274,10 +280,164 @@ struct ExpStmt: Statement {
 	~ExpStmt() { delete value; }
 	void code() override {
 		unique_ptr<Object> v = move(value->code());
-		repl_print(v->str());
+		repl_print(v.get());
+	}
+};
+
+struct YieldStmt: Statement {
+	Expression* value;
+
+	YieldStmt(Expression* e): value(e) { stype = StmtType::YIELD; }
+	~YieldStmt() { delete value; }
+	void code() override {
+		// only reached outside a generator, where the value has nowhere to go
+		unique_ptr<Object> v = move(value->code());
+	}
+};
+
+// a function body is a generator if it yields anywhere outside nested fn literals
+inline bool has_yield(StmtWrapper* s) {
+	for (auto stmt : s->stmts) {
+		if (stmt->stype == StmtType::YIELD) return true;
+		if (stmt->stype == StmtType::IF) {
+			IfStmt* f = (IfStmt*)stmt;
+			if (has_yield(f->then->stmt_list) || (f->els != nullptr && has_yield(f->els->stmt_list))) return true;
+		}
+	}
+	return false;
+}
+
+// --------------------------------
+
+// lazy sequences. next() produces one value at a time, nullptr once the
+// sequence is exhausted. clones of a Gen share its state, so reading a
+// generator through a name does not restart it.
+struct GenState {
+	virtual unique_ptr<Object> next() = 0;
+	virtual ~GenState() {}
+};
+
+struct Gen : Object {
+	shared_ptr<GenState> state;
+
+	Gen(shared_ptr<GenState> s): state(s) { otype = ObjType::GEN; value = nullptr; }
+	string str() const override { return "generator"; }
+};
+
+// a suspended call of a generator function. the body runs as a stackless
+// coroutine: pcs holds the statement list and resume index of the body
+// and of every if block entered, and scopes the matching env scopes,
+// which live off the env stack while suspended.
+struct FnGen : GenState {
+	shared_ptr<BlockStmt> body;
+	vector<pair<StmtWrapper*, size_t>> pcs;
+	vector<unique_ptr<Scope>> scopes;
+	bool running = false;
+
+	FnGen(shared_ptr<BlockStmt> b, unique_ptr<Scope> s): body(b) {
+		pcs.push_back({ b->stmt_list, 0 });
+		scopes.push_back(move(s));
+	}
+
+	unique_ptr<Object> next() override {
+		if (running) return make_unique<Error>(ErrorType::UNSOP, "generator resumed while running");
+		if (pcs.empty()) return nullptr;
+
+		running = true;
+		for (auto& s : scopes) env_stack->stack.push_back(move(s));
+		scopes.clear();
+
+		unique_ptr<Object> v;
+		while (v == nullptr && !pcs.empty()) {
+			auto& pc = pcs.back();
+			if (pc.second == pc.first->stmts.size()) {
+				pcs.pop_back();
+				env_stack->stack.pop_back();
+				continue;
+			}
+
+			Statement* stmt = pc.first->stmts[pc.second++];
+			switch (stmt->stype) {
+				case StmtType::YIELD:
+					v = move(((YieldStmt*)stmt)->value->code());
+					break;
+				case StmtType::IF: {
+					IfStmt* f = (IfStmt*)stmt;
+					unique_ptr<Object> cond = move(f->cond->code());
+					if (cond->otype != ObjType::BOOL) break;
+					BlockStmt* b = obj_vcast<bool>(cond.get()) ? f->then : f->els;
+					if (b == nullptr) break;
+					env_stack->push_scope();
+					pcs.push_back({ b->stmt_list, 0 });
+					break;
+				}
+				default: stmt->code();
+			}
+		}
+
+		// suspend: take the live scopes back off the env stack
+		auto& st = env_stack->stack;
+		for (auto it = st.end() - pcs.size(); it != st.end(); ++it) scopes.push_back(move(*it));
+		st.erase(st.end() - pcs.size(), st.end());
+		running = false;
+		return v;
 	}
 };
 
+// runs fn with its parameters already bound in the top scope, which is
+// popped. a generator function instead keeps that scope and returns a Gen
+inline unique_ptr<Object> fn_run(Fn* fn) {
+	if (fn->body->generator) {
+		unique_ptr<Scope> s = move(env_stack->stack.back());
+		env_stack->stack.pop_back();
+		return make_unique<Gen>(make_shared<FnGen>(fn->body, move(s)));
+	}
+
+	// execute the function body 
+	for (int i = 0; i < fn->body->stmt_list->stmts.size(); i++)
+		fn->body->stmt_list->stmts[i]->code();
+
+	// retrieve return value from the local scope before popping it
+	unique_ptr<Object> value = env_stack->find_and_own("return");
+	env_stack->pop_scope();
+	return move(value);
+}
+
+// calls f with already evaluated arguments, for builtins taking functions
+inline unique_ptr<Object> apply(Object* f, Object** argv, size_t argc) {
+	if (f->otype == ObjType::BF) {
+		BuiltIn* bf = (BuiltIn*)f;
+		if (bf->arity != argc)
+			return make_unique<Error>(ErrorType::ARG, "bf::" + bf->id + "() expects " + to_string(bf->arity) + " arguments");
+		return bf->thunk(bf->fn, argv, bf->id);
+	}
+	if (f->otype != ObjType::FN)
+		return make_unique<Error>(ErrorType::TYPE, f->str() + " is not callable");
+
+	Fn* fn = (Fn*)f;
+	if (fn->params->args.size() != argc)
+		return make_unique<Error>(ErrorType::ARG, "fn expects " + to_string(fn->params->args.size()) + " arguments");
+
+	// the arguments are already values, so the JIT can be tried before
+	// any scope is built
+	if (jit_enabled && argc <= JIT_MAX_ARGS) {
+		unique_ptr<Object> value = jit_call(fn, argv, argc);
+		if (value != nullptr) return move(value);
+	}
+
+	env_stack->push_scope();
+	env_stack->create("return", make_unique<Null>());
+	for (size_t i = 0; i < argc; i++) {
+		string name = *(fn->params->args[i]);
+		if (env_stack->redeclaration(name)) {
+			env_stack->pop_scope();
+			return make_unique<Error>(ErrorType::REDECL, name);
+		}
+		env_stack->create(name, obj_clone(argv[i]));
+	}
+	return fn_run(fn);
+}
+
 // --------------------------------
 
 struct Call: Expression {
@@ -289,28 +449,33 @@ struct Call: Expression {
 	unique_ptr<Object> code() override {
 		unique_ptr<Object> value;
 
-		if (env_stack->undefined(id))
+		Object* callee = env_stack->find(id);
+		if (callee == nullptr)
 			return make_unique<Error>(ErrorType::UNDEF, id);
 
-		unique_ptr<Object> obj = move(env_stack->find_and_clone(id));
-
-		switch (obj->otype) {
+		switch (callee->otype) {
 			case ObjType::BF: {
-				unique_ptr<BuiltIn> bf = static_unique_ptr_cast<BuiltIn>(move(obj));
-				if (bf->args->args.size() != args->exps.size())
-					return make_unique<Error>(ErrorType::ARG, "bf::" + id + "() expects " + to_string(bf->args->args.size()) + " arguments");
-
-				vector<unique_ptr<Object>> exps;
-				for (int i = 0; i < args->exps.size(); i++)
-					exps.push_back(move(args->exps[i]->code()));
-
-				value = move(bf->code(move(exps)));
-				return move(value);
+				// called in place, without cloning the builtin. only fn and thunk
+				// are kept since evaluating the arguments may rebind id
+				BuiltIn* bf = (BuiltIn*)callee;
+				BfPtr f = bf->fn;
+				BfThunk thunk = bf->thunk;
+				if (bf->arity != args->exps.size())
+					return make_unique<Error>(ErrorType::ARG, "bf::" + id + "() expects " + to_string(bf->arity) + " arguments");
+
+				unique_ptr<Object> exps[BF_MAX_ARGS];
+				Object* argv[BF_MAX_ARGS];
+				for (int i = 0; i < args->exps.size(); i++) {
+					exps[i] = move(args->exps[i]->code());
+					argv[i] = exps[i].get();
+				}
+				return thunk(f, argv, id);
 			}
 			case ObjType::FN: break;
 			default: return make_unique<Error>(ErrorType::TYPE, id);
 		}
 
+		unique_ptr<Object> obj = move(obj_clone(callee));
 		unique_ptr<Fn> fn = static_unique_ptr_cast<Fn>(move(obj));
 		if (fn->params->args.size() != args->exps.size())
 			return make_unique<Error>(ErrorType::ARG, id + " expects " + to_string(fn->params->args.size()) + " arguments");
@@ -332,14 +497,21 @@ struct Call: Expression {
 			env_stack->create(name, move(v));
 		}
 
-		// execute the function body 
-		for (int i = 0; i < fn->body->stmt_list->stmts.size(); i++)
-			fn->body->stmt_list->stmts[i]->code();
+		// hot numeric functions may run as native code. nullptr means the JIT
+		// declined or deoptimized, and the body is interpreted as usual
+		if (jit_enabled && args->exps.size() <= JIT_MAX_ARGS) {
+			Object* argv[JIT_MAX_ARGS];
+			for (int i = 0; i < args->exps.size(); i++)
+				argv[i] = env_stack->stack.back()->find(*(fn->params->args[i])).get();
 
-		// retrieve return value from the local scope before popping it
-		value = env_stack->find_and_own("return");
-		env_stack->pop_scope();
-		return move(value);
+			value = jit_call(fn.get(), argv, args->exps.size());
+			if (value != nullptr) {
+				env_stack->pop_scope();
+				return move(value);
+			}
+		}
+
+		return fn_run(fn.get());
 	}
 };
 
@@ -350,8 +522,8 @@ struct Const: Expression {
 	Const(string v, ConstType t): ctype(t) {
 		etype = ExpType::CONST;
 		switch (t) {
-			case ConstType::INT: cv = make_unique<Int>(stoi(v)); break;
-			case ConstType::FLT: cv = make_unique<Double>(stof(v)); break;
+			case ConstType::INT: cv = v.size() < 19 ? make_unique<Int>(stoll(v)) : int_object(Big::parse(v)); break;
+			case ConstType::FLT: cv = make_unique<Double>(stod(v)); break;
 			case ConstType::STR: cv = make_unique<String>(v); break;
 			default: 
 				cerr << "[error] Const::Const(string v, ConstType t)" << endl;
@@ -370,6 +542,7 @@ struct Const: Expression {
 		etype = ExpType::CONST;
 		cv = make_unique<Fn>(p, b);
 	}
+	Const(unique_ptr<Object> v, ConstType t): ctype(t), cv(move(v)) { etype = ExpType::CONST; }
 	unique_ptr<Object> code() override {
 		return move(obj_clone(cv.get()));
 	}
@@ -399,8 +572,10 @@ struct PrefixExp : Expression {
 		unique_ptr<Object> rv = move(right->code());
 		switch (op) {
 			case PrefixOp::NEG:
-				if (rv->otype == ObjType::INT)
-					return make_unique<Int>(- obj_vcast<int>(rv.get()));
+				if (rv->otype == ObjType::INT && obj_vcast<int64_t>(rv.get()) != INT64_MIN)
+					return make_unique<Int>(- obj_vcast<int64_t>(rv.get()));
+				else if (is_int(rv.get()))
+					return int_object(- to_big(rv.get()));
 				else if (rv->otype == ObjType::FLT)
 					return make_unique<Double>(- obj_vcast<double>(rv.get()));
 				else
@@ -419,20 +594,51 @@ struct PrefixExp : Expression {
 	}
 };
 
+// int arithmetic that overflowed 64 bits or involves a BigInt
+inline unique_ptr<Object> big_infix(Object* l, InfixOp op, Object* r) {
+	Big a = to_big(l), b = to_big(r);
+	switch (op) {
+		case InfixOp::ADD: return int_object(a + b);
+		case InfixOp::SUB: return int_object(a - b);
+		case InfixOp::MUL: return int_object(a * b);
+		case InfixOp::DIV:
+		case InfixOp::MOD:
+			if (b.zero()) return make_unique<Error>(ErrorType::UNSOP, l->str() + infix_str[op] + r->str());
+			return int_object(op == InfixOp::DIV ? a / b : a % b);
+		case InfixOp::EQ: return make_unique<Bool>(a.cmp(b) == 0);
+		case InfixOp::NE: return make_unique<Bool>(a.cmp(b) != 0);
+		case InfixOp::LT: return make_unique<Bool>(a.cmp(b) < 0);
+		case InfixOp::LE: return make_unique<Bool>(a.cmp(b) <= 0);
+		case InfixOp::GT: return make_unique<Bool>(a.cmp(b) > 0);
+		case InfixOp::GE: return make_unique<Bool>(a.cmp(b) >= 0);
+		default: return make_unique<Error>(ErrorType::UNSOP, l->str() + infix_str[op] + r->str());
+	}
+}
+
 struct InfixExp : Expression {
 	Expression* left;
 	InfixOp op;
 	Expression* right;
 
 	InfixExp(Expression* l, InfixOp o, Expression* r): left(l), op(o), right(r) { etype = ExpType::INFIX; }
-	~InfixExp() { delete left, right; }
+	~InfixExp() {
+		delete left;
+		delete right;
+	}
 	unique_ptr<Object> code() override {
 		unique_ptr<Object> lv = move(left->code());
 		unique_ptr<Object> rv = move(right->code());
 
+		// any operation involving an int beyond 64 bits
+		if (is_int(lv.get()) && is_int(rv.get()) && lv->otype != rv->otype)
+			return big_infix(lv.get(), op, rv.get());
+
 		if (lv->otype != rv->otype)
 			return make_unique<Error>(ErrorType::TYPE, lv->str() + infix_str[op] + rv->str());
 		
+		if (lv->otype == ObjType::BIG)
+			return big_infix(lv.get(), op, rv.get());
+
 		ObjType t = lv->otype;
 		bool v = false;
 		bool inv = false;
@@ -440,7 +646,12 @@ struct InfixExp : Expression {
 		switch (op) {
 			case InfixOp::ADD:
 				switch (t) {
-					case ObjType::INT: return make_unique<Int>(obj_vcast<int>(lv.get()) + obj_vcast<int>(rv.get()));
+					case ObjType::INT: {
+						int64_t r;
+						if (__builtin_add_overflow(obj_vcast<int64_t>(lv.get()), obj_vcast<int64_t>(rv.get()), &r))
+							return big_infix(lv.get(), op, rv.get());
+						return make_unique<Int>(r);
+					}
 					case ObjType::FLT: return make_unique<Double>(obj_vcast<double>(lv.get()) + obj_vcast<double>(rv.get()));
 					case ObjType::STR: return make_unique<String>(obj_vcast<string>(lv.get()) + obj_vcast<string>(rv.get()));
 					default: inv = true;
@@ -448,34 +659,54 @@ struct InfixExp : Expression {
 				break;
 			case InfixOp::SUB:
 				switch (t) {
-					case ObjType::INT: return make_unique<Int>(obj_vcast<int>(lv.get()) - obj_vcast<int>(rv.get()));
+					case ObjType::INT: {
+						int64_t r;
+						if (__builtin_sub_overflow(obj_vcast<int64_t>(lv.get()), obj_vcast<int64_t>(rv.get()), &r))
+							return big_infix(lv.get(), op, rv.get());
+						return make_unique<Int>(r);
+					}
 					case ObjType::FLT: return make_unique<Double>(obj_vcast<double>(lv.get()) - obj_vcast<double>(rv.get()));
 					default: inv = true;
 				}
 				break;
 			case InfixOp::MUL:
 				switch (t) {
-					case ObjType::INT: return make_unique<Int>(obj_vcast<int>(lv.get()) * obj_vcast<int>(rv.get()));
+					case ObjType::INT: {
+						int64_t r;
+						if (__builtin_mul_overflow(obj_vcast<int64_t>(lv.get()), obj_vcast<int64_t>(rv.get()), &r))
+							return big_infix(lv.get(), op, rv.get());
+						return make_unique<Int>(r);
+					}
 					case ObjType::FLT: return make_unique<Double>(obj_vcast<double>(lv.get()) * obj_vcast<double>(rv.get()));
 					default: inv = true;
 				}
 				break;
 			case InfixOp::DIV:
 				switch (t) {
-					case ObjType::INT: return make_unique<Int>(obj_vcast<int>(lv.get()) / obj_vcast<int>(rv.get()));
+					case ObjType::INT: {
+						int64_t a = obj_vcast<int64_t>(lv.get()), b = obj_vcast<int64_t>(rv.get());
+						if (b == 0 || (a == INT64_MIN && b == -1))
+							return big_infix(lv.get(), op, rv.get());
+						return make_unique<Int>(a / b);
+					}
 					case ObjType::FLT: return make_unique<Double>(obj_vcast<double>(lv.get()) / obj_vcast<double>(rv.get()));
 					default: inv = true;
 				}
 				break;
 			case InfixOp::MOD:
 				switch (t) {
-					case ObjType::INT: return make_unique<Int>(obj_vcast<int>(lv.get()) % obj_vcast<int>(rv.get()));
+					case ObjType::INT: {
+						int64_t a = obj_vcast<int64_t>(lv.get()), b = obj_vcast<int64_t>(rv.get());
+						if (b == 0 || (a == INT64_MIN && b == -1))
+							return big_infix(lv.get(), op, rv.get());
+						return make_unique<Int>(a % b);
+					}
 					default: inv = true;
 				}
 				break;
 			case InfixOp::EQ:
 				switch (t) {
-					case ObjType::INT: v = obj_vcast<int>(lv.get()) == obj_vcast<int>(rv.get()); break;
+					case ObjType::INT: v = obj_vcast<int64_t>(lv.get()) == obj_vcast<int64_t>(rv.get()); break;
 					case ObjType::FLT: v = obj_vcast<double>(lv.get()) == obj_vcast<double>(rv.get()); break;
 					case ObjType::STR: v = obj_vcast<string>(lv.get()) == obj_vcast<string>(rv.get()); break;
 					case ObjType::BOOL: v = obj_vcast<bool>(lv.get()) == obj_vcast<bool>(rv.get()); break;
@@ -486,7 +717,7 @@ struct InfixExp : Expression {
 				break;
 			case InfixOp::NE:
 				switch (t) {
-					case ObjType::INT: v = obj_vcast<int>(lv.get()) != obj_vcast<int>(rv.get()); break;
+					case ObjType::INT: v = obj_vcast<int64_t>(lv.get()) != obj_vcast<int64_t>(rv.get()); break;
 					case ObjType::FLT: v = obj_vcast<double>(lv.get()) != obj_vcast<double>(rv.get()); break;
 					case ObjType::STR: v = obj_vcast<string>(lv.get()) != obj_vcast<string>(rv.get()); break;
 					case ObjType::BOOL: v = obj_vcast<bool>(lv.get()) != obj_vcast<bool>(rv.get()); break;
@@ -497,7 +728,7 @@ struct InfixExp : Expression {
 				break;
 			case InfixOp::LT:
 				switch (t) {
-					case ObjType::INT: v = obj_vcast<int>(lv.get()) < obj_vcast<int>(rv.get()); break;
+					case ObjType::INT: v = obj_vcast<int64_t>(lv.get()) < obj_vcast<int64_t>(rv.get()); break;
 					case ObjType::FLT: v = obj_vcast<double>(lv.get()) < obj_vcast<double>(rv.get()); break;
 					default: inv = true;
 				}
@@ -505,7 +736,7 @@ struct InfixExp : Expression {
 				break;
 			case InfixOp::LE:
 				switch (t) {
-					case ObjType::INT: v = obj_vcast<int>(lv.get()) <= obj_vcast<int>(rv.get()); break;
+					case ObjType::INT: v = obj_vcast<int64_t>(lv.get()) <= obj_vcast<int64_t>(rv.get()); break;
 					case ObjType::FLT: v = obj_vcast<double>(lv.get()) <= obj_vcast<double>(rv.get()); break;
 					default: inv = true;
 				}
@@ -513,7 +744,7 @@ struct InfixExp : Expression {
 				break;
 			case InfixOp::GT:
 				switch (t) {
-					case ObjType::INT: v = obj_vcast<int>(lv.get()) > obj_vcast<int>(rv.get()); break;
+					case ObjType::INT: v = obj_vcast<int64_t>(lv.get()) > obj_vcast<int64_t>(rv.get()); break;
 					case ObjType::FLT: v = obj_vcast<double>(lv.get()) > obj_vcast<double>(rv.get()); break;
 					default: inv = true;
 				}
@@ -521,7 +752,7 @@ struct InfixExp : Expression {
 				break;
 			case InfixOp::GE:
 				switch (t) {
-					case ObjType::INT: v = obj_vcast<int>(lv.get()) >= obj_vcast<int>(rv.get()); break;
+					case ObjType::INT: v = obj_vcast<int64_t>(lv.get()) >= obj_vcast<int64_t>(rv.get()); break;
 					case ObjType::FLT: v = obj_vcast<double>(lv.get()) >= obj_vcast<double>(rv.get()); break;
 					default: inv = true;
 				}
@@ -545,4 +776,10 @@ struct InfixExp : Expression {
 	}
 };
 
+// names referenced anywhere in a block, statement or expression, function
+// bodies included, added to r
+void refs_block(StmtWrapper* b, unordered_set<string>& r);
+void refs_stmt(Statement* s, unordered_set<string>& r);
+void refs_exp(Expression* e, unordered_set<string>& r);
+
 #endif
\ No newline at end of file
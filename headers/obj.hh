@@ -2,6 +2,8 @@
 #define OBJ_HH
 
 #include "base.hh"
+#include "big.hh"
+#include "out.hh"
 
 enum class ObjType {
 	INT,
@@ -14,35 +16,69 @@ enum class ObjType {
 	BF,
 	LIST,
 	DICT,
+	BIG,
+	GEN,
 };
 
 struct Object {
 	void* value;
 	ObjType otype;
 
+	virtual ~Object() {}
 	virtual string str() const = 0;
+
+	// writes str() to o, overridden to skip building the string
+	virtual void put(Out& o) const { o.write(str()); }
 };
 
 template<typename T>
-static T obj_vcast(Object *v) { return *(T*)(void*)(v->value); }
+inline T obj_vcast(Object *v) { return *(T*)(void*)(v->value); }
 
 unique_ptr<Object> obj_clone(Object* obj);
 
 // --------------------------------
 
 struct Int : Object {
-	Int(int v = 0) {
+	Int(int64_t v = 0) {
 		otype = ObjType::INT;
-		value = (void*)(new int(v));
+		value = (void*)(new int64_t(v));
+	}
+
+	string str() const override {
+		return to_string(*(int64_t*)value);
+	}
+
+	void put(Out& o) const override { o.put_int(*(int64_t*)value); }
+
+	~Int() { delete (int64_t*)value; }
+};
+
+// an int outside the 64 bit range. to the language it is still an int
+struct BigInt : Object {
+	BigInt(const Big& v) {
+		otype = ObjType::BIG;
+		value = (void*)(new Big(v));
 	}
 
 	string str() const override {
-		return to_string(*(int*)value);
+		return ((Big*)value)->str();
 	}
 
-	~Int() { delete (int*)value; }
+	~BigInt() { delete (Big*)value; }
 };
 
+// ints are kept canonical: a BigInt only when the value needs it
+inline unique_ptr<Object> int_object(const Big& v) {
+	if (v.fits_i64()) return make_unique<Int>(v.to_i64());
+	return make_unique<BigInt>(v);
+}
+
+inline bool is_int(Object* obj) { return obj->otype == ObjType::INT || obj->otype == ObjType::BIG; }
+
+inline Big to_big(Object* obj) {
+	return obj->otype == ObjType::BIG ? *(Big*)obj->value : Big(*(int64_t*)obj->value);
+}
+
 struct Double : Object {
 	Double(double v = 0) {
 		otype = ObjType::FLT;
@@ -53,6 +89,8 @@ struct Double : Object {
 		return to_string(*(double*)value);
 	}
 
+	void put(Out& o) const override { o.put_double(*(double*)value); }
+
 	~Double() { delete (double*)value; }
 };
 
@@ -64,11 +102,22 @@ struct String : Object {
 		value = (void*)(new string(v));
 	}
 
+	String(const char* s, size_t n, bool q = true): quotes(q) {
+		otype = ObjType::STR;
+		value = (void*)(new string(s, n));
+	}
+
 	string str() const override {
 		string s = *(string*)value;
 		return quotes ? '\"' + s + '\"' : s;
 	}
 
+	void put(Out& o) const override {
+		if (quotes) o.put('"');
+		o.write(*(string*)value);
+		if (quotes) o.put('"');
+	}
+
 	~String() { delete (string*)value; }
 };
 
@@ -82,6 +131,8 @@ struct Bool : Object {
 		return *(bool*)value ? "true" : "false";
 	}
 
+	void put(Out& o) const override { o.write(*(bool*)value ? "true" : "false"); }
+
 	~Bool() { delete (bool*)value; }
 };
 
@@ -104,6 +155,7 @@ enum class ErrorType {
 	TYPE,
 	UNSOP,
 	ARG,
+	IO,
 	UNK,
 };
 
@@ -124,6 +176,7 @@ struct Error : Object {
 			case ErrorType::TYPE: s += "[type]: "; break;
 			case ErrorType::UNSOP: s += "[unsupported_operation]: "; break;
 			case ErrorType::ARG: s += "[arg]: "; break;
+			case ErrorType::IO: s += "[io]: "; break;
 			case ErrorType::UNK: s += "[unknown]: "; break;
 		}
 		return s + v;
@@ -0,0 +1,82 @@
+#ifndef OUT_HH
+#define OUT_HH
+
+#include "base.hh"
+#include <cstring>
+#include <unistd.h>
+
+// buffered stdout. everything the interpreter prints goes through out,
+// which is flushed when full, at exit, by the flush() builtin, and after
+// every line when stdout is a terminal. while capture is set, output
+// is appended to it instead of written out.
+struct Out {
+	static const size_t SIZE = 1 << 16;
+
+	char buf[SIZE];
+	size_t len = 0;
+	bool line = false;
+	string* capture = nullptr;
+
+	static void write_all(const char* s, size_t n) {
+		while (n) {
+			ssize_t w = ::write(1, s, n);
+			if (w <= 0) return;
+			s += w;
+			n -= w;
+		}
+	}
+
+	void sink(const char* s, size_t n) {
+		if (capture != nullptr) capture->append(s, n);
+		else write_all(s, n);
+	}
+
+	void flush() {
+		sink(buf, len);
+		len = 0;
+	}
+
+	void write(const char* s, size_t n) {
+		if (n > SIZE - len) {
+			flush();
+			if (n >= SIZE) return sink(s, n);
+		}
+		memcpy(buf + len, s, n);
+		len += n;
+	}
+	void write(const string& s) { write(s.data(), s.size()); }
+	void write(const char* s) { write(s, strlen(s)); }
+
+	void put(char c) {
+		if (len == SIZE) flush();
+		buf[len++] = c;
+	}
+
+	void put_int(int64_t v) {
+		char tmp[20];
+		uint64_t u = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+		int i = sizeof(tmp);
+		do {
+			tmp[--i] = '0' + u % 10;
+			u /= 10;
+		} while (u);
+		if (v < 0) put('-');
+		write(tmp + i, sizeof(tmp) - i);
+	}
+
+	// same format as to_string(double)
+	void put_double(double v) {
+		const size_t room = 512;
+		if (SIZE - len < room) flush();
+		len += snprintf(buf + len, room, "%f", v);
+	}
+
+	void newline() {
+		put('\n');
+		if (line) flush();
+	}
+};
+
+extern Out out;
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef PAR_HH
+#define PAR_HH
+
+#include "obj.hh"
+
+// data-parallel evaluation on a pool of worker threads, see par.cc
+
+// set on worker threads
+extern thread_local bool par_worker;
+
+// f applied to every element of xs, in input order
+vector<unique_ptr<Object>> par_map(Object* f, const vector<unique_ptr<Object>>& xs);
+
+// xs cut into chunks, each folded with f starting from its first element.
+// the chunk results, in input order
+vector<unique_ptr<Object>> par_fold(Object* f, const vector<unique_ptr<Object>>& xs);
+
+#endif
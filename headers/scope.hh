@@ -27,6 +27,11 @@ struct Scope {
 struct EnvStack {
 	std::vector<std::unique_ptr<Scope>> stack;
 
+	// when set, every name bound or rebound in the global scope is
+	// appended to it with the value it had before, nullptr if none. watch
+	// mode uses this to record what a statement wrote and to undo it
+	vector<pair<string, unique_ptr<Object>>>* log = nullptr;
+
 	EnvStack() { stack.push_back(std::make_unique<Scope>()); }
 
 	bool undefined(const string& name) {
@@ -38,6 +43,13 @@ struct EnvStack {
 		if (stack.back()->scope.find(name) != stack.back()->scope.end()) return true;
 		return false;
 	}
+	Object* find(const string& name) {
+		for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+			auto v = (*it)->scope.find(name);
+			if (v != (*it)->scope.end()) return v->second.get();
+		}
+		return nullptr;
+	}
 	unique_ptr<Object> find_and_own(const string& name) {
 		for (auto it = stack.rbegin(); it != stack.rend(); ++it)
 			if ((*it)->scope.find(name) != (*it)->scope.end()) 
@@ -56,11 +68,13 @@ struct EnvStack {
 		exit(1);
 	}
 	void create(const string& k, unique_ptr<Object> v) {
+		if (log != nullptr && stack.size() == 1) log->push_back({ k, nullptr });
         stack.back()->insert(k, move(v));
     }
 	void update(const string& k, unique_ptr<Object> v) {
 		for (auto it = stack.rbegin(); it != stack.rend(); ++it)
 			if ((*it)->scope.find(k) != (*it)->scope.end()) {
+				if (log != nullptr && it + 1 == stack.rend()) log->push_back({ k, move((*it)->scope[k]) });
 				(*it)->scope[k] = move(v);
 				return;
 			}
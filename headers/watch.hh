@@ -0,0 +1,10 @@
+#ifndef WATCH_HH
+#define WATCH_HH
+
+#include "base.hh"
+
+// runs the script at path, then reruns it incrementally every time the
+// file changes, see watch.cc. does not return unless path is unreadable
+int watch(const string& path);
+
+#endif
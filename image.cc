@@ -0,0 +1,316 @@
+// heap images: `zeal --snapshot out.img prelude.mk` evaluates a prelude
+// and writes its global scope to out.img, and `zeal --image out.img` binds
+// it again at startup without lexing, parsing or evaluating anything.
+//
+// an image is a flat little endian byte stream with no pointers in it:
+// a header, the number of globals, then each global as its name and a
+// tagged value. functions carry their AST. a body is written in full the
+// first time it is seen and by index after that, so clones of a function
+// share one body again once loaded, as they did when saved (the JIT keys
+// its state by body). builtins are bound by init() and generators hold
+// running state, so neither is written.
+
+#include "zeal.hh"
+#include <algorithm>
+
+static const char IMAGE_MAGIC[8] = { 'z', 'e', 'a', 'l', 'i', 'm', 'g', '1' };
+
+// --------------------------------
+
+struct ImageWriter {
+	string buf;
+	unordered_map<BlockStmt*, uint32_t> bodies;
+
+	void u8(uint8_t v) { buf.push_back(v); }
+	void u32(uint32_t v) { for (int i = 0; i < 4; i++) buf.push_back(v >> (8 * i)); }
+	void u64(uint64_t v) { for (int i = 0; i < 8; i++) buf.push_back(v >> (8 * i)); }
+	void str(const string& s) { u32(s.size()); buf += s; }
+
+	void obj(Object* o) {
+		u8((uint8_t)o->otype);
+		switch (o->otype) {
+			case ObjType::INT: u64(obj_vcast<int64_t>(o)); break;
+			case ObjType::FLT: { double d = obj_vcast<double>(o); uint64_t b; memcpy(&b, &d, 8); u64(b); break; }
+			case ObjType::STR: str(obj_vcast<string>(o)); u8(((String*)o)->quotes); break;
+			case ObjType::BOOL: u8(obj_vcast<bool>(o)); break;
+			case ObjType::ERR: u8((uint8_t)((Error*)o)->err_type); str(obj_vcast<string>(o)); break;
+			case ObjType::BIG: {
+				const Big& b = obj_vcast<Big>(o);
+				u8(b.neg);
+				u32(b.mag.size());
+				for (auto limb : b.mag) u32(limb);
+				break;
+			}
+			case ObjType::FN: {
+				Fn* fn = (Fn*)o;
+				auto it = bodies.find(fn->body.get());
+				if (it != bodies.end()) {
+					u32(it->second);
+					break;
+				}
+				uint32_t i = bodies.size();
+				bodies[fn->body.get()] = i;
+				u32(i);
+				u32(fn->params->args.size());
+				for (auto p : fn->params->args) str(*p);
+				block(fn->body->stmt_list);
+				break;
+			}
+			default: break;
+		}
+	}
+
+	void block(StmtWrapper* b) {
+		u32(b->stmts.size());
+		for (auto s : b->stmts) stmt(s);
+	}
+
+	void stmt(Statement* s) {
+		u8((uint8_t)s->stype);
+		switch (s->stype) {
+			case StmtType::LET: str(((LetStmt*)s)->id); exp(((LetStmt*)s)->rhs); break;
+			case StmtType::ASG: str(((AsgStmt*)s)->id); exp(((AsgStmt*)s)->rhs); break;
+			case StmtType::RETURN: exp(((RetStmt*)s)->value); break;
+			case StmtType::EXP: exp(((ExpStmt*)s)->value); break;
+			case StmtType::YIELD: exp(((YieldStmt*)s)->value); break;
+			case StmtType::IF: {
+				IfStmt* f = (IfStmt*)s;
+				exp(f->cond);
+				block(f->then->stmt_list);
+				u8(f->els != nullptr);
+				if (f->els != nullptr) block(f->els->stmt_list);
+				break;
+			}
+		}
+	}
+
+	void exp(Expression* e) {
+		u8((uint8_t)e->etype);
+		switch (e->etype) {
+			case ExpType::CONST: u8((uint8_t)((Const*)e)->ctype); obj(((Const*)e)->cv.get()); break;
+			case ExpType::ID: str(((Idf*)e)->name); break;
+			case ExpType::PREFIX: u8((uint8_t)((PrefixExp*)e)->op); exp(((PrefixExp*)e)->right); break;
+			case ExpType::INFIX: {
+				InfixExp* i = (InfixExp*)e;
+				exp(i->left);
+				u8((uint8_t)i->op);
+				exp(i->right);
+				break;
+			}
+			case ExpType::CALL: {
+				Call* c = (Call*)e;
+				str(c->id);
+				u32(c->args->exps.size());
+				for (auto a : c->args->exps) exp(a);
+				break;
+			}
+		}
+	}
+};
+
+string image_save(const string& path) {
+	ImageWriter w;
+	w.buf.append(IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+
+	// sorted, so that the same prelude always gives the same image
+	vector<pair<string, Object*>> globals;
+	for (auto& kv : env_stack->stack[0]->scope)
+		if (kv.second->otype != ObjType::BF && kv.second->otype != ObjType::GEN)
+			globals.push_back({ kv.first, kv.second.get() });
+	sort(globals.begin(), globals.end());
+
+	w.u32(globals.size());
+	for (auto& g : globals) {
+		w.str(g.first);
+		w.obj(g.second);
+	}
+	return write_file(path, w.buf);
+}
+
+// --------------------------------
+
+// the object types a literal of type t can hold. the rest of the
+// interpreter relies on it, e.g. a FN literal is cast to Fn*
+static bool const_fits(ConstType t, ObjType o) {
+	switch (t) {
+		case ConstType::INT: return o == ObjType::INT || o == ObjType::BIG;
+		case ConstType::FLT: return o == ObjType::FLT;
+		case ConstType::STR: return o == ObjType::STR;
+		case ConstType::BOOL: return o == ObjType::BOOL;
+		case ConstType::NONE: return o == ObjType::NONE;
+		case ConstType::FN: return o == ObjType::FN;
+	}
+	return false;
+}
+
+// reads never run past end. any malformed input sets bad, after which
+// every read returns zero and the partial result is thrown away
+struct ImageReader {
+	const char* p;
+	const char* end;
+	bool bad = false;
+	vector<pair<shared_ptr<ArgWrapper>, shared_ptr<BlockStmt>>> bodies;
+
+	ImageReader(const char* p, const char* end): p(p), end(end) {}
+
+	bool need(size_t n) {
+		if (!bad && (size_t)(end - p) >= n) return true;
+		bad = true;
+		return false;
+	}
+	uint8_t u8() { return need(1) ? (uint8_t)*p++ : 0; }
+	uint32_t u32() {
+		if (!need(4)) return 0;
+		uint32_t v = 0;
+		for (int i = 0; i < 4; i++) v |= (uint32_t)(uint8_t)*p++ << (8 * i);
+		return v;
+	}
+	uint64_t u64() {
+		if (!need(8)) return 0;
+		uint64_t v = 0;
+		for (int i = 0; i < 8; i++) v |= (uint64_t)(uint8_t)*p++ << (8 * i);
+		return v;
+	}
+	string str() {
+		uint32_t n = u32();
+		if (!need(n)) return "";
+		string s(p, n);
+		p += n;
+		return s;
+	}
+	// a count of items that each take at least one byte
+	uint32_t count() {
+		uint32_t n = u32();
+		return need(n) ? n : 0;
+	}
+
+	unique_ptr<Object> obj() {
+		switch ((ObjType)u8()) {
+			case ObjType::INT: return make_unique<Int>((int64_t)u64());
+			case ObjType::FLT: { uint64_t b = u64(); double d; memcpy(&d, &b, 8); return make_unique<Double>(d); }
+			case ObjType::STR: { string s = str(); return make_unique<String>(s, u8() != 0); }
+			case ObjType::BOOL: return make_unique<Bool>(u8() != 0);
+			case ObjType::NONE: return make_unique<Null>();
+			case ObjType::ERR: {
+				uint8_t t = u8();
+				if (t > (uint8_t)ErrorType::UNK) bad = true;
+				return make_unique<Error>((ErrorType)t, str());
+			}
+			case ObjType::BIG: {
+				bool neg = u8() != 0;
+				Limbs mag(count());
+				for (auto& limb : mag) limb = u32();
+				return int_object(Big(neg, mag));
+			}
+			case ObjType::FN: {
+				uint32_t i = u32();
+				if (i < bodies.size() && bodies[i].second != nullptr) return make_unique<Fn>(bodies[i].first, bodies[i].second);
+				if (i != bodies.size()) break;
+
+				shared_ptr<ArgWrapper> params = make_shared<ArgWrapper>();
+				for (uint32_t n = count(); n > 0; n--) params->push_back(new string(str()));
+				// registered before the body, like the writer does, so the
+				// indices of fn literals inside it line up
+				bodies.push_back({ params, nullptr });
+				shared_ptr<BlockStmt> body = make_shared<BlockStmt>(block());
+				bodies[i].second = body;
+				return make_unique<Fn>(params, body);
+			}
+			default: break;
+		}
+		bad = true;
+		return make_unique<Null>();
+	}
+
+	StmtWrapper* block() {
+		StmtWrapper* b = new StmtWrapper();
+		for (uint32_t n = count(); n > 0 && !bad; n--) b->push_back(stmt());
+		return b;
+	}
+
+	Statement* stmt() {
+		switch ((StmtType)u8()) {
+			case StmtType::LET: { string id = str(); return new LetStmt(id, exp()); }
+			case StmtType::ASG: { string id = str(); return new AsgStmt(id, exp()); }
+			case StmtType::RETURN: return new RetStmt(exp());
+			case StmtType::EXP: return new ExpStmt(exp());
+			case StmtType::YIELD: return new YieldStmt(exp());
+			case StmtType::IF: {
+				Expression* cond = exp();
+				BlockStmt* then = new BlockStmt(block());
+				BlockStmt* els = u8() ? new BlockStmt(block()) : nullptr;
+				return new IfStmt(cond, then, els);
+			}
+			default: break;
+		}
+		bad = true;
+		return new ExpStmt(new Const());
+	}
+
+	Expression* exp() {
+		switch ((ExpType)u8()) {
+			case ExpType::CONST: {
+				uint8_t t = u8();
+				if (t > (uint8_t)ConstType::FN) break;
+				unique_ptr<Object> v = obj();
+				if (!const_fits((ConstType)t, v->otype)) break;
+				return new Const(move(v), (ConstType)t);
+			}
+			case ExpType::ID: return new Idf(str());
+			case ExpType::PREFIX: {
+				uint8_t op = u8();
+				if (op > (uint8_t)PrefixOp::NOT) break;
+				return new PrefixExp((PrefixOp)op, exp());
+			}
+			case ExpType::INFIX: {
+				Expression* l = exp();
+				uint8_t op = u8();
+				if (op > (uint8_t)InfixOp::OR) {
+					delete l;
+					break;
+				}
+				return new InfixExp(l, (InfixOp)op, exp());
+			}
+			case ExpType::CALL: {
+				string id = str();
+				ExpWrapper* args = new ExpWrapper();
+				for (uint32_t n = count(); n > 0 && !bad; n--) args->push_back(exp());
+				return new Call(id, args);
+			}
+			default: break;
+		}
+		bad = true;
+		return new Const();
+	}
+};
+
+string image_load(const string& path) {
+	Reader in;
+	if (!in.open(path)) return in.err;
+
+	// regular files are mapped already, anything else is read whole
+	string data;
+	if (in.map == nullptr) {
+		while (in.fill()) {
+			data.append(in.p, in.end);
+			in.p = in.end;
+		}
+		if (!in.err.empty()) return in.err;
+		in.p = data.data();
+		in.end = data.data() + data.size();
+	}
+
+	if (in.end - in.p < (ptrdiff_t)sizeof(IMAGE_MAGIC) || memcmp(in.p, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)))
+		return path + ": not a zeal image";
+
+	ImageReader r(in.p + sizeof(IMAGE_MAGIC), in.end);
+	vector<pair<string, unique_ptr<Object>>> globals;
+	for (uint32_t n = r.count(); n > 0 && !r.bad; n--) {
+		string name = r.str();
+		globals.push_back({ name, r.obj() });
+	}
+	if (r.bad || r.p != r.end) return path + ": corrupt image";
+
+	for (auto& g : globals) env_stack->create(g.first, move(g.second));
+	return "";
+}
@@ -0,0 +1,576 @@
+// baseline JIT for hot numeric functions (x86-64 only).
+//
+// calls are counted per function body. once a function reaches
+// jit_threshold calls with int/double/bool arguments, it is compiled
+// for those argument types by stitching together fixed machine code
+// templates into an mmap'd buffer. only bodies made of let, return and
+// if statements over constants, locals, prefix/infix operators and calls
+// to itself (under any name bound to it) are eligible. such bodies have no side effects, so on any
+// guard failure (overflow, division by zero, a null return) the native
+// frames are simply abandoned and the interpreter runs the call again
+// from the arguments it already bound.
+//
+// pmap/preduce workers share compiled code with the main thread. they
+// may compile a function nobody has compiled yet, but never free or
+// replace code, since another worker could be running it; that is left
+// to the main thread, which only runs while the workers are idle.
+
+#include "zeal.hh"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <sys/mman.h>
+
+bool jit_enabled = true;
+size_t jit_threshold = 1000;
+thread_local bool jit_worker = false;
+
+#if defined(__x86_64__)
+
+enum class JitType {
+	UNK,
+	INT,
+	FLT,
+	BOOL,
+};
+
+struct JitVar {
+	string name;
+	JitType t;
+	int32_t off;
+};
+
+// functions that deoptimize this often are given back to the interpreter
+const size_t JIT_MAX_DEOPTS = 100;
+
+static JitType jit_type(Object* obj) {
+	switch (obj->otype) {
+		case ObjType::INT: return JitType::INT;
+		case ObjType::FLT: return JitType::FLT;
+		case ObjType::BOOL: return JitType::BOOL;
+		default: return JitType::UNK;
+	}
+}
+
+static uint64_t jit_bits(Object* obj) {
+	uint64_t b = 0;
+	switch (obj->otype) {
+		case ObjType::INT: b = (uint64_t)obj_vcast<int64_t>(obj); break;
+		case ObjType::FLT: { double d = obj_vcast<double>(obj); memcpy(&b, &d, 8); break; }
+		case ObjType::BOOL: b = obj_vcast<bool>(obj); break;
+		default: break;
+	}
+	return b;
+}
+
+static unique_ptr<Object> jit_box(JitType t, uint64_t b) {
+	switch (t) {
+		case JitType::INT: return make_unique<Int>((int64_t)b);
+		case JitType::FLT: { double d; memcpy(&d, &b, 8); return make_unique<Double>(d); }
+		case JitType::BOOL: return make_unique<Bool>(b != 0);
+		default: return make_unique<Null>();
+	}
+}
+
+static uint8_t* jit_map(const vector<uint8_t>& code) {
+	void* p = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED) return nullptr;
+	memcpy(p, code.data(), code.size());
+	if (mprotect(p, code.size(), PROT_READ | PROT_EXEC) != 0) {
+		munmap(p, code.size());
+		return nullptr;
+	}
+	return (uint8_t*)p;
+}
+
+// --------------------------------
+
+// code generation. every expression leaves its value in rax, doubles as
+// their bit pattern. frame slots are addressed off rbp. the compiled function takes a
+// pointer to its argument slots in rdi, and returns the value in rax with
+// rdx = 1, or rdx = 0 if no return statement ran.
+struct JitCompiler {
+	Fn* fn;
+	vector<JitType> params;
+	JitType ret;
+
+	vector<uint8_t> code;
+	vector<size_t> deopts;
+	vector<vector<JitVar>> scopes;
+	// the names self calls go through, see jit_bound()
+	vector<string> selves;
+	int32_t nslots = 0;
+	int32_t ret_off, flag_off;
+	bool ok = true;
+
+	JitCompiler(Fn* fn, const vector<JitType>& p, JitType r): fn(fn), params(p), ret(r) {}
+
+	void emit(initializer_list<uint8_t> b) { code.insert(code.end(), b); }
+	void emit32(int32_t v) { for (int i = 0; i < 4; i++) code.push_back((uint32_t)v >> (8 * i)); }
+	void emit64(uint64_t v) { for (int i = 0; i < 8; i++) code.push_back(v >> (8 * i)); }
+
+	void mov_imm(uint64_t v) { emit({ 0x48, 0xb8 }); emit64(v); }		// mov rax, imm64
+	void load(int32_t off) { emit({ 0x48, 0x8b, 0x85 }); emit32(off); }	// mov rax, [rbp+off]
+	void store(int32_t off) { emit({ 0x48, 0x89, 0x85 }); emit32(off); }	// mov [rbp+off], rax
+	void set_flag(int32_t off, int32_t v) { emit({ 0x48, 0xc7, 0x85 }); emit32(off); emit32(v); }
+
+	size_t jcc(uint8_t cc) { emit({ 0x0f, cc }); emit32(0); return code.size() - 4; }
+	size_t jmp() { emit({ 0xe9 }); emit32(0); return code.size() - 4; }
+	void patch(size_t at, size_t to) { int32_t rel = to - (at + 4); memcpy(&code[at], &rel, 4); }
+	void deopt_if(uint8_t cc) { deopts.push_back(jcc(cc)); }
+
+	// n contiguous slots, element i at the returned offset + 8*i
+	int32_t slot(int n = 1) { nslots += n; return -8 * nslots; }
+
+	JitType fail() { ok = false; return JitType::UNK; }
+
+	JitVar* lookup(const string& name) {
+		for (auto s = scopes.rbegin(); s != scopes.rend(); ++s)
+			for (auto& v : *s)
+				if (v.name == name) return &v;
+		return nullptr;
+	}
+
+	// --------------------------------
+
+	JitType exp(Expression* e) {
+		if (!ok) return JitType::UNK;
+		switch (e->etype) {
+			case ExpType::CONST: {
+				Object* cv = ((Const*)e)->cv.get();
+				JitType t = jit_type(cv);
+				if (t == JitType::UNK) return fail();
+				mov_imm(jit_bits(cv));
+				return t;
+			}
+			case ExpType::ID: {
+				JitVar* v = lookup(((Idf*)e)->name);
+				if (v == nullptr) return fail();
+				load(v->off);
+				return v->t;
+			}
+			case ExpType::PREFIX: return prefix((PrefixExp*)e);
+			case ExpType::INFIX: return infix((InfixExp*)e);
+			case ExpType::CALL: return call((Call*)e);
+			default: return fail();
+		}
+	}
+
+	JitType prefix(PrefixExp* e) {
+		JitType t = exp(e->right);
+		switch (e->op) {
+			case PrefixOp::NEG:
+				if (t == JitType::INT) {
+					emit({ 0x48, 0xf7, 0xd8 });						// neg rax
+					deopt_if(0x80);									// jo
+				} else if (t == JitType::FLT)
+					emit({ 0x48, 0x0f, 0xba, 0xf8, 0x3f });			// btc rax, 63
+				else if (t != JitType::UNK) return fail();
+				return t;
+			case PrefixOp::NOT:
+				if (t == JitType::BOOL) emit({ 0x83, 0xf0, 0x01 });	// xor eax, 1
+				else if (t != JitType::UNK) return fail();
+				return JitType::BOOL;
+			default: return fail();
+		}
+	}
+
+	JitType infix(InfixExp* e) {
+		JitType lt = exp(e->left);
+		emit({ 0x50 });												// push rax
+		JitType rt = exp(e->right);
+		emit({ 0x48, 0x89, 0xc1, 0x58 });							// mov rcx, rax; pop rax
+		if (lt != JitType::UNK && rt != JitType::UNK && lt != rt) return fail();
+
+		JitType t = lt != JitType::UNK ? lt : rt;
+		switch (t) {
+			case JitType::INT: return int_op(e->op);
+			case JitType::FLT: return flt_op(e->op);
+			case JitType::BOOL: return bool_op(e->op);
+			default:
+				// only while inferring the return type
+				if (e->op == InfixOp::ADD || e->op == InfixOp::SUB || e->op == InfixOp::MUL || e->op == InfixOp::DIV || e->op == InfixOp::MOD)
+					return JitType::UNK;
+				return JitType::BOOL;
+		}
+	}
+
+	JitType setcc(uint8_t cc) {
+		emit({ 0x0f, cc, 0xc0, 0x0f, 0xb6, 0xc0 });				// setcc al; movzx eax, al
+		return JitType::BOOL;
+	}
+
+	JitType int_op(InfixOp op) {
+		switch (op) {
+			case InfixOp::ADD: emit({ 0x48, 0x01, 0xc8 }); break;		// add rax, rcx
+			case InfixOp::SUB: emit({ 0x48, 0x29, 0xc8 }); break;		// sub rax, rcx
+			case InfixOp::MUL: emit({ 0x48, 0x0f, 0xaf, 0xc1 }); break;	// imul rax, rcx
+			case InfixOp::DIV:
+			case InfixOp::MOD:
+				emit({ 0x48, 0x85, 0xc9 });							// test rcx, rcx
+				deopt_if(0x84);										// jz
+				emit({ 0x48, 0x83, 0xf9, 0xff, 0x75, 0x13 });		// cmp rcx, -1; jne +19
+				emit({ 0x48, 0xba }); emit64(INT64_MIN);			// mov rdx, INT64_MIN
+				emit({ 0x48, 0x39, 0xd0 });							// cmp rax, rdx
+				deopt_if(0x84);										// je
+				emit({ 0x48, 0x99, 0x48, 0xf7, 0xf9 });				// cqo; idiv rcx
+				if (op == InfixOp::MOD) emit({ 0x48, 0x89, 0xd0 });	// mov rax, rdx
+				return JitType::INT;
+			case InfixOp::EQ: emit({ 0x48, 0x39, 0xc8 }); return setcc(0x94);	// cmp rax, rcx
+			case InfixOp::NE: emit({ 0x48, 0x39, 0xc8 }); return setcc(0x95);
+			case InfixOp::LT: emit({ 0x48, 0x39, 0xc8 }); return setcc(0x9c);
+			case InfixOp::LE: emit({ 0x48, 0x39, 0xc8 }); return setcc(0x9e);
+			case InfixOp::GT: emit({ 0x48, 0x39, 0xc8 }); return setcc(0x9f);
+			case InfixOp::GE: emit({ 0x48, 0x39, 0xc8 }); return setcc(0x9d);
+			default: return fail();
+		}
+		deopt_if(0x80);												// jo
+		return JitType::INT;
+	}
+
+	JitType flt_op(InfixOp op) {
+		emit({ 0x66, 0x48, 0x0f, 0x6e, 0xc0 });					// movq xmm0, rax
+		emit({ 0x66, 0x48, 0x0f, 0x6e, 0xc9 });					// movq xmm1, rcx
+		switch (op) {
+			case InfixOp::ADD: emit({ 0xf2, 0x0f, 0x58, 0xc1 }); break;	// addsd xmm0, xmm1
+			case InfixOp::SUB: emit({ 0xf2, 0x0f, 0x5c, 0xc1 }); break;	// subsd xmm0, xmm1
+			case InfixOp::MUL: emit({ 0xf2, 0x0f, 0x59, 0xc1 }); break;	// mulsd xmm0, xmm1
+			case InfixOp::DIV: emit({ 0xf2, 0x0f, 0x5e, 0xc1 }); break;	// divsd xmm0, xmm1
+			// ucomisd flags NaN as unordered (zf = pf = cf = 1), which all of these treat as false
+			case InfixOp::EQ:
+				emit({ 0x66, 0x0f, 0x2e, 0xc1 });						// ucomisd xmm0, xmm1
+				emit({ 0x0f, 0x94, 0xc0, 0x0f, 0x9b, 0xc1, 0x20, 0xc8 });	// sete al; setnp cl; and al, cl
+				emit({ 0x0f, 0xb6, 0xc0 });
+				return JitType::BOOL;
+			case InfixOp::NE:
+				emit({ 0x66, 0x0f, 0x2e, 0xc1 });
+				emit({ 0x0f, 0x95, 0xc0, 0x0f, 0x9a, 0xc1, 0x08, 0xc8 });	// setne al; setp cl; or al, cl
+				emit({ 0x0f, 0xb6, 0xc0 });
+				return JitType::BOOL;
+			case InfixOp::GT: emit({ 0x66, 0x0f, 0x2e, 0xc1 }); return setcc(0x97);	// seta
+			case InfixOp::GE: emit({ 0x66, 0x0f, 0x2e, 0xc1 }); return setcc(0x93);	// setae
+			case InfixOp::LT: emit({ 0x66, 0x0f, 0x2e, 0xc8 }); return setcc(0x97);	// ucomisd xmm1, xmm0; seta
+			case InfixOp::LE: emit({ 0x66, 0x0f, 0x2e, 0xc8 }); return setcc(0x93);
+			default: return fail();
+		}
+		emit({ 0x66, 0x48, 0x0f, 0x7e, 0xc0 });					// movq rax, xmm0
+		return JitType::FLT;
+	}
+
+	JitType bool_op(InfixOp op) {
+		switch (op) {
+			case InfixOp::EQ: emit({ 0x39, 0xc8 }); return setcc(0x94);
+			case InfixOp::NE: emit({ 0x39, 0xc8 }); return setcc(0x95);
+			case InfixOp::AND: emit({ 0x21, 0xc8 }); return JitType::BOOL;	// and eax, ecx
+			case InfixOp::OR: emit({ 0x09, 0xc8 }); return JitType::BOOL;		// or eax, ecx
+			default: return fail();
+		}
+	}
+
+	// a call by name reaches fn itself if the name, looked up the way the
+	// interpreter would from here, is bound to a clone of it. the body is
+	// what they share, so it does not matter how fn itself was reached
+	bool is_self(const string& name) {
+		Object* o = env_stack->find(name);
+		return o != nullptr && o->otype == ObjType::FN && ((Fn*)o)->body == fn->body;
+	}
+
+	// only calls to the function itself
+	JitType call(Call* e) {
+		size_t n = params.size();
+		if (lookup(e->id) != nullptr || !is_self(e->id) || e->args->exps.size() != n) return fail();
+		if (find(selves.begin(), selves.end(), e->id) == selves.end()) selves.push_back(e->id);
+
+		// as in Call::code(), argument i is evaluated with params 0..i-1
+		// of the callee already bound
+		int32_t area = slot(n);
+		scopes.push_back({});
+		for (size_t i = 0; i < n; i++) {
+			JitType t = exp(e->args->exps[i]);
+			if (t != JitType::UNK && t != params[i]) return fail();
+			store(area + 8 * i);
+			scopes.back().push_back({ *(fn->params->args[i]), params[i], area + 8 * (int32_t)i });
+		}
+		scopes.pop_back();
+
+		emit({ 0x48, 0x8d, 0xbd }); emit32(area);					// lea rdi, [rbp+area]
+		emit({ 0xe8 }); emit32(-(int32_t)(code.size() + 4));		// call entry
+		emit({ 0x85, 0xd2 });										// test edx, edx
+		deopt_if(0x84);												// jz: a null return
+		return ret;
+	}
+
+	// --------------------------------
+
+	void stmt(Statement* s) {
+		if (!ok) return;
+		switch (s->stype) {
+			case StmtType::RETURN: {
+				JitType t = exp(((RetStmt*)s)->value);
+				if (t != JitType::UNK) {
+					if (ret == JitType::UNK) ret = t;
+					else if (t != ret) { fail(); return; }
+				}
+				store(ret_off);
+				set_flag(flag_off, 1);
+				break;
+			}
+			case StmtType::LET: {
+				LetStmt* l = (LetStmt*)s;
+				JitType t = exp(l->rhs);
+				for (auto& v : scopes.back())
+					if (v.name == l->id) return; // redeclaration, the value is dropped
+				int32_t off = slot();
+				store(off);
+				scopes.back().push_back({ l->id, t, off });
+				break;
+			}
+			case StmtType::IF: {
+				IfStmt* f = (IfStmt*)s;
+				JitType t = exp(f->cond);
+				if (t != JitType::BOOL && t != JitType::UNK) { fail(); return; }
+				emit({ 0x85, 0xc0 });								// test eax, eax
+				size_t to_else = jcc(0x84);							// jz
+				block(f->then);
+				if (f->els != nullptr) {
+					size_t to_end = jmp();
+					patch(to_else, code.size());
+					block(f->els);
+					patch(to_end, code.size());
+				} else patch(to_else, code.size());
+				break;
+			}
+			default: fail();
+		}
+	}
+
+	void block(BlockStmt* b) {
+		scopes.push_back({});
+		for (auto s : b->stmt_list->stmts) stmt(s);
+		scopes.pop_back();
+	}
+
+	bool compile() {
+		for (size_t i = 0; i < params.size(); i++)
+			for (size_t j = 0; j < i; j++)
+				if (*(fn->params->args[i]) == *(fn->params->args[j])) return false;
+
+		emit({ 0x55, 0x48, 0x89, 0xe5 });							// push rbp; mov rbp, rsp
+		emit({ 0x48, 0x81, 0xec });									// sub rsp, frame
+		size_t frame_at = code.size();
+		emit32(0);
+
+		ret_off = slot();
+		flag_off = slot();
+		set_flag(flag_off, 0);
+
+		scopes.push_back({});
+		for (size_t i = 0; i < params.size(); i++) {
+			int32_t off = slot();
+			emit({ 0x48, 0x8b, 0x87 }); emit32(8 * i);				// mov rax, [rdi+8*i]
+			store(off);
+			scopes.back().push_back({ *(fn->params->args[i]), params[i], off });
+		}
+		for (auto s : fn->body->stmt_list->stmts) stmt(s);
+		scopes.pop_back();
+
+		load(ret_off);
+		emit({ 0x48, 0x8b, 0x95 }); emit32(flag_off);				// mov rdx, [rbp+flag]
+		emit({ 0xc9, 0xc3 });										// leave; ret
+
+		// deopt stub: unwind every native frame back to the trampoline, whose
+		// rsp is kept in r12 (compiled code never touches r8-r15)
+		size_t stub = code.size();
+		emit({ 0x4c, 0x89, 0xe4 });									// mov rsp, r12
+		emit({ 0xb8 }); emit32(2);									// mov eax, 2
+		emit({ 0x41, 0x5c, 0x5b, 0x5d, 0xc3 });					// pop r12; pop rbx; pop rbp; ret
+		for (auto at : deopts) patch(at, stub);
+
+		int32_t frame = (8 * nslots + 15) & ~15;
+		memcpy(&code[frame_at], &frame, 4);
+		return ok && ret != JitType::UNK;
+	}
+};
+
+// --------------------------------
+
+// int entry(void* fn, uint64_t* args, uint64_t* out): returns 1 with the
+// result in *out, 0 for a null result, or 2 after a deopt
+typedef int (*JitEntry)(uint8_t* fn, uint64_t* args, uint64_t* out);
+
+static JitEntry jit_entry() {
+	static JitEntry entry = nullptr;
+	if (entry != nullptr) return entry;
+
+	JitCompiler c(nullptr, {}, JitType::UNK);
+	c.emit({ 0x55, 0x53, 0x41, 0x54 });							// push rbp; push rbx; push r12
+	c.emit({ 0x48, 0x89, 0xd3 });								// mov rbx, rdx
+	c.emit({ 0x49, 0x89, 0xe4 });								// mov r12, rsp
+	c.emit({ 0x48, 0x89, 0xf8, 0x48, 0x89, 0xf7 });				// mov rax, rdi; mov rdi, rsi
+	c.emit({ 0xff, 0xd0 });										// call rax
+	c.emit({ 0x48, 0x89, 0x03 });								// mov [rbx], rax
+	c.emit({ 0x89, 0xd0 });										// mov eax, edx
+	c.emit({ 0x41, 0x5c, 0x5b, 0x5d, 0xc3 });					// pop r12; pop rbx; pop rbp; ret
+	entry = (JitEntry)jit_map(c.code);
+	return entry;
+}
+
+struct JitFn {
+	vector<JitType> types;
+	// argument types that did not compile. any code compiled for other
+	// types is kept
+	vector<vector<JitType>> rejected;
+	vector<string> selves;
+	JitType ret = JitType::UNK;
+	uint8_t* code = nullptr;
+	size_t size = 0;
+	size_t calls = 0;
+	size_t deopts = 0;
+	bool failed = false;
+
+	void release() {
+		if (code != nullptr) munmap(code, size);
+		code = nullptr;
+	}
+};
+
+// keyed by body, which every clone of a function literal shares
+static unordered_map<BlockStmt*, JitFn> jit_fns;
+
+static bool jit_match(JitFn& jf, Object** argv, size_t argc) {
+	if (jf.code == nullptr) return false;
+	for (size_t i = 0; i < argc; i++)
+		if (jit_type(argv[i]) != jf.types[i]) return false;
+	return true;
+}
+
+// the code calls itself directly wherever the body called one of
+// jf.selves, which holds while they are still bound to the function. the
+// native frames never rebind anything, so checking on entry is enough
+static bool jit_bound(JitFn& jf, Fn* fn) {
+	for (auto& name : jf.selves) {
+		Object* o = env_stack->find(name);
+		if (o == nullptr || o->otype != ObjType::FN || ((Fn*)o)->body != fn->body) return false;
+	}
+	return true;
+}
+
+static vector<JitType> jit_types(Object** argv, size_t argc) {
+	vector<JitType> types;
+	for (size_t i = 0; i < argc; i++) types.push_back(jit_type(argv[i]));
+	return types;
+}
+
+static bool jit_rejected(JitFn& jf, const vector<JitType>& types) {
+	return find(jf.rejected.begin(), jf.rejected.end(), types) != jf.rejected.end();
+}
+
+static bool jit_compile(JitFn& jf, Fn* fn, Object** argv, size_t argc) {
+	vector<JitType> types = jit_types(argv, argc);
+	if (find(types.begin(), types.end(), JitType::UNK) != types.end() || jit_rejected(jf, types)) return false;
+
+	// a dry run infers the return type, which self calls depend on
+	JitCompiler infer(fn, types, JitType::UNK);
+	bool ok = infer.compile();
+	JitCompiler c(fn, types, infer.ret);
+	uint8_t* code = ok && c.compile() && jit_entry() != nullptr ? jit_map(c.code) : nullptr;
+	if (code == nullptr) {
+		jf.rejected.push_back(types);
+		return false;
+	}
+
+	jf.release();
+	jf.types = types;
+	jf.ret = c.ret;
+	jf.selves = c.selves;
+	jf.code = code;
+	jf.size = c.code.size();
+	return true;
+}
+
+// workers touch jit_fns only under jit_lock, and keep copies of the
+// entries that are compiled, failed or rejected these argument types, so
+// that calling those takes no lock. the copies are dropped by
+// jit_forget() at the start of every job.
+static mutex jit_lock;
+static thread_local unordered_map<BlockStmt*, JitFn> jit_seen;
+
+void jit_forget() {
+	jit_seen.clear();
+}
+
+static unique_ptr<Object> jit_call_worker(Fn* fn, Object** argv, size_t argc) {
+	for (size_t i = 0; i < argc; i++)
+		if (jit_type(argv[i]) == JitType::UNK) return nullptr;
+
+	// still counting calls towards compiling for these types
+	auto pending = [&](JitFn& jf) {
+		return !jf.failed && jf.code == nullptr && !jit_rejected(jf, jit_types(argv, argc));
+	};
+
+	BlockStmt* body = fn->body.get();
+	auto it = jit_seen.find(body);
+	if (it == jit_seen.end() || pending(it->second)) {
+		lock_guard<mutex> l(jit_lock);
+		JitFn& jf = jit_fns[body];
+		if (pending(jf)) {
+			if (++jf.calls < jit_threshold) return nullptr;
+			jf.calls = 0;
+			jit_compile(jf, fn, argv, argc);
+		}
+		jit_seen[body] = jf;
+		it = jit_seen.find(body);
+	}
+
+	JitFn& jf = it->second;
+	if (jf.failed || !jit_match(jf, argv, argc) || !jit_bound(jf, fn)) return nullptr;
+
+	uint64_t args[JIT_MAX_ARGS], out = 0;
+	for (size_t i = 0; i < argc; i++) args[i] = jit_bits(argv[i]);
+
+	switch (jit_entry()(jf.code, args, &out)) {
+		case 0: return make_unique<Null>();
+		case 1: return jit_box(jf.ret, out);
+		default:
+			if (++jf.deopts > JIT_MAX_DEOPTS) jf.failed = true;
+			return nullptr;
+	}
+}
+
+unique_ptr<Object> jit_call(Fn* fn, Object** argv, size_t argc) {
+	if (jit_worker) return jit_call_worker(fn, argv, argc);
+
+	JitFn& jf = jit_fns[fn->body.get()];
+	if (jf.failed) return nullptr;
+
+	if (!jit_match(jf, argv, argc)) {
+		if (++jf.calls < jit_threshold) return nullptr;
+		jf.calls = 0;
+		if (!jit_compile(jf, fn, argv, argc)) return nullptr;
+	}
+	if (!jit_bound(jf, fn)) return nullptr;
+
+	uint64_t args[JIT_MAX_ARGS], out = 0;
+	for (size_t i = 0; i < argc; i++) args[i] = jit_bits(argv[i]);
+
+	switch (jit_entry()(jf.code, args, &out)) {
+		case 0: return make_unique<Null>();
+		case 1: return jit_box(jf.ret, out);
+		default:
+			if (++jf.deopts > JIT_MAX_DEOPTS) {
+				jf.release();
+				jf.failed = true;
+			}
+			return nullptr;
+	}
+}
+
+#else
+
+void jit_forget() {}
+
+unique_ptr<Object> jit_call(Fn* fn, Object** argv, size_t argc) {
+	return nullptr;
+}
+
+#endif
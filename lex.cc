@@ -0,0 +1,297 @@
+// hand-written scanner, a drop-in replacement for the flex scanner in zeal.l
+// (build with `make LEXER=hand`). it emits the same token stream for bison,
+// tracks line/column without rescanning, and reports every unknown
+// character instead of exiting on the first. yylex_errors counts them, and
+// the driver does not run input that had any.
+
+#include "zeal.hh"
+#include "parse.tab.h"
+#include <cctype>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+FILE *yyin = nullptr;
+int yylineno = 1;
+int yycolumn = 1; // of the token just returned
+int yylex_errors = 0;
+
+// the whole input is read up front; the parser only executes the program
+// once it has been fully reduced, so nothing is lost by not streaming.
+// PAD zero bytes follow the input so that 16 byte loads never run past
+// the buffer, and a 0 never matches any of the classes scanned below.
+static const size_t PAD = 16;
+static vector<char> buf;
+static const char *cur = nullptr;
+static const char *buf_end = nullptr;
+static const char *line_start = nullptr;
+
+static void lex_load() {
+	if (yyin == nullptr) yyin = stdin;
+	buf.clear();
+	size_t n = 0;
+	buf.resize(1 << 16);
+	while (true) {
+		size_t r = fread(buf.data() + n, 1, buf.size() - n, yyin);
+		n += r;
+		if (r == 0) break;
+		if (n == buf.size()) buf.resize(buf.size() * 2);
+	}
+	buf.resize(n + PAD, '\0');
+	cur = line_start = buf.data();
+	buf_end = buf.data() + n;
+}
+
+void yyrestart(FILE *f) {
+	yyin = f;
+	yylineno = yycolumn = 1;
+	yylex_errors = 0;
+	cur = buf_end = line_start = nullptr;
+}
+
+// --------------------------------
+
+#ifdef __SSE2__
+
+static inline unsigned mask_ws(__m128i c) {
+	__m128i m = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\t')));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(c, _mm_set1_epi8('\n')));
+	return _mm_movemask_epi8(m);
+}
+
+static inline __m128i in_range(__m128i c, char lo, char hi) {
+	// bytes >= 0x80 compare as negative, so they never fall in an ascii range
+	return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8(hi + 1)));
+}
+
+static inline unsigned mask_idf(__m128i c) {
+	__m128i m = in_range(_mm_or_si128(c, _mm_set1_epi8(0x20)), 'a', 'z');
+	m = _mm_or_si128(m, in_range(c, '0', '9'));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(c, _mm_set1_epi8('_')));
+	return _mm_movemask_epi8(m);
+}
+
+static inline unsigned mask_nl(__m128i c) {
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')));
+}
+
+static inline unsigned mask_str_stop(__m128i c) {
+	__m128i m = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('"')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\\')));
+	return _mm_movemask_epi8(_mm_or_si128(m, _mm_cmpeq_epi8(c, _mm_setzero_si128())));
+}
+
+static inline __m128i load16(const char *p) { return _mm_loadu_si128((const __m128i*)p); }
+
+// [ \t\n]*, counting newlines as it goes
+static const char* skip_ws(const char *p) {
+	while (true) {
+		__m128i c = load16(p);
+		unsigned stop = ~mask_ws(c) & 0xffff;
+		unsigned nl = mask_nl(c);
+		if (stop) {
+			int k = __builtin_ctz(stop);
+			nl &= (1u << k) - 1;
+			if (nl) {
+				yylineno += __builtin_popcount(nl);
+				line_start = p + 32 - __builtin_clz(nl);
+			}
+			return p + k;
+		}
+		if (nl) {
+			yylineno += __builtin_popcount(nl);
+			line_start = p + 32 - __builtin_clz(nl);
+		}
+		p += 16;
+	}
+}
+
+// {letter}({letter}|{digit})*, p points past the leading letter
+static const char* skip_idf(const char *p) {
+	while (true) {
+		unsigned stop = ~mask_idf(load16(p)) & 0xffff;
+		if (stop) return p + __builtin_ctz(stop);
+		p += 16;
+	}
+}
+
+// "//".* up to (not including) the newline
+static const char* skip_comment(const char *p) {
+	while (p < buf_end) {
+		__m128i c = load16(p);
+		unsigned stop = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(c, _mm_setzero_si128())));
+		if (stop) {
+			p += __builtin_ctz(stop);
+			if (*p == '\n' || p >= buf_end) break;
+			p++; // a literal NUL inside the comment
+		} else p += 16;
+	}
+	return p < buf_end ? p : buf_end;
+}
+
+// [^\"\\]* up to the closing quote, a backslash or a NUL
+static const char* skip_str(const char *p, int& lines, const char*& last_nl) {
+	while (true) {
+		__m128i c = load16(p);
+		unsigned stop = mask_str_stop(c);
+		unsigned nl = mask_nl(c);
+		if (stop) {
+			int k = __builtin_ctz(stop);
+			nl &= (1u << k) - 1;
+			if (nl) {
+				lines += __builtin_popcount(nl);
+				last_nl = p + 31 - __builtin_clz(nl);
+			}
+			return p + k;
+		}
+		if (nl) {
+			lines += __builtin_popcount(nl);
+			last_nl = p + 31 - __builtin_clz(nl);
+		}
+		p += 16;
+	}
+}
+
+#else
+
+static const char* skip_ws(const char *p) {
+	for (;; p++) {
+		if (*p == '\n') yylineno++, line_start = p + 1;
+		else if (*p != ' ' && *p != '\t') return p;
+	}
+}
+
+static const char* skip_idf(const char *p) {
+	while (isalnum((unsigned char)*p) || *p == '_') p++;
+	return p;
+}
+
+static const char* skip_comment(const char *p) {
+	while (p < buf_end && *p != '\n') p++;
+	return p;
+}
+
+static const char* skip_str(const char *p, int& lines, const char*& last_nl) {
+	for (; *p != '"' && *p != '\\' && *p != '\0'; p++)
+		if (*p == '\n') lines++, last_nl = p;
+	return p;
+}
+
+#endif
+
+// --------------------------------
+
+static inline bool is_letter(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+static inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+static int keyword(const char *s, size_t n) {
+	switch (n) {
+		case 2:
+			if (!memcmp(s, "if", 2)) return IF;
+			if (!memcmp(s, "fn", 2)) return FN;
+			break;
+		case 3:
+			if (!memcmp(s, "let", 3)) return LET;
+			break;
+		case 4:
+			if (!memcmp(s, "true", 4)) return TRUE_VAL;
+			if (!memcmp(s, "else", 4)) return ELSE;
+			if (!memcmp(s, "null", 4)) return NULL_VAL;
+			break;
+		case 5:
+			if (!memcmp(s, "false", 5)) return FALSE_VAL;
+			if (!memcmp(s, "yield", 5)) return YIELD;
+			break;
+		case 6:
+			if (!memcmp(s, "return", 6)) return RETURN;
+			break;
+	}
+	return IDF;
+}
+
+static void lex_error(const char *p) {
+	fprintf(stderr, "unknown_token: %d at %d:%d\n", *p, yylineno, yycolumn);
+	yylex_errors++;
+}
+
+int yylex(void) {
+	if (cur == nullptr) lex_load();
+
+	while (true) {
+		cur = skip_ws(cur);
+		if (cur >= buf_end) {
+			cur = buf_end;
+			yycolumn = (int)(cur - line_start) + 1;
+			return 0;
+		}
+
+		const char *p = cur;
+		yycolumn = (int)(p - line_start) + 1;
+
+		switch (*p) {
+			case '/':
+				if (p[1] == '/') { cur = skip_comment(p + 2); continue; }
+				cur = p + 1; return '/';
+			case '=':
+				if (p[1] == '=') { cur = p + 2; return EQ; }
+				cur = p + 1; return '=';
+			case '!':
+				if (p[1] == '=') { cur = p + 2; return NE; }
+				cur = p + 1; return '!';
+			case '<':
+				if (p[1] == '=') { cur = p + 2; return LE; }
+				cur = p + 1; return '<';
+			case '>':
+				if (p[1] == '=') { cur = p + 2; return GE; }
+				cur = p + 1; return '>';
+			case '&':
+				if (p[1] == '&') { cur = p + 2; return AND; }
+				break;
+			case '|':
+				if (p[1] == '|') { cur = p + 2; return OR; }
+				break;
+			case ';': case ',': case ':': case '?': case '+': case '-': case '*': case '%': case '^':
+			case '(': case ')': case '{': case '}': case '[': case ']':
+				cur = p + 1; return *p;
+			case '"': {
+				int lines = 0;
+				const char *last_nl = nullptr;
+				const char *q = skip_str(p + 1, lines, last_nl);
+				while (*q == '\0' && q < buf_end) q = skip_str(q + 1, lines, last_nl);
+				if (*q != '"' || q >= buf_end) break; // same as flex: a lone quote is unknown
+				yylval.name = new string(p + 1, q - p - 1);
+				if (lines) yylineno += lines, line_start = last_nl + 1;
+				cur = q + 1;
+				return STR_VAL;
+			}
+			case '.':
+				if (!is_digit(p[1])) break;
+				/* fallthrough */
+			case '0': case '1': case '2': case '3': case '4':
+			case '5': case '6': case '7': case '8': case '9': {
+				const char *q = p;
+				while (is_digit(*q)) q++;
+				int tok = INT_VAL;
+				if (*q == '.') {
+					tok = FLT_VAL;
+					q++;
+					while (is_digit(*q)) q++;
+				}
+				yylval.name = new string(p, q - p);
+				cur = q;
+				return tok;
+			}
+			default:
+				if (is_letter(*p)) {
+					const char *q = skip_idf(p + 1);
+					int tok = keyword(p, q - p);
+					if (tok == IDF) yylval.name = new string(p, q - p);
+					cur = q;
+					return tok;
+				}
+		}
+
+		lex_error(p);
+		cur = p + 1;
+	}
+}
@@ -0,0 +1,62 @@
+// token dump driver, linked against either scanner so their output can be
+// diffed token-for-token (`make lexcheck`) and timed (`make lexbench`).
+// usage: lexdump [-q] < file
+
+#include "zeal.hh"
+#include "parse.tab.h"
+#include <cstring>
+#include <chrono>
+
+YYSTYPE yylval;
+extern int yylex(void);
+extern int yylineno;
+
+static string tok_name(int t) {
+	switch (t) {
+		case LET: return "LET";
+		case RETURN: return "RETURN";
+		case TRUE_VAL: return "TRUE_VAL";
+		case FALSE_VAL: return "FALSE_VAL";
+		case IF: return "IF";
+		case ELSE: return "ELSE";
+		case EQ: return "EQ";
+		case NE: return "NE";
+		case LE: return "LE";
+		case GE: return "GE";
+		case AND: return "AND";
+		case OR: return "OR";
+		case INT_VAL: return "INT_VAL";
+		case FLT_VAL: return "FLT_VAL";
+		case IDF: return "IDF";
+		case STR_VAL: return "STR_VAL";
+		case NULL_VAL: return "NULL_VAL";
+		case FN: return "FN";
+		case YIELD: return "YIELD";
+		default: return string("'") + (char)t + "'";
+	}
+}
+
+static bool has_text(int t) {
+	return t == INT_VAL || t == FLT_VAL || t == IDF || t == STR_VAL;
+}
+
+int main(int argc, char **argv) {
+	bool quiet = argc > 1 && !strcmp(argv[1], "-q");
+	size_t count = 0, bytes = 0;
+
+	auto t0 = chrono::steady_clock::now();
+	for (int t; (t = yylex()) != 0; count++) {
+		if (has_text(t)) {
+			bytes += yylval.name->size();
+			if (!quiet) cout << yylineno << ' ' << tok_name(t) << ' ' << *yylval.name << '\n';
+			delete yylval.name;
+		} else if (!quiet) cout << yylineno << ' ' << tok_name(t) << '\n';
+	}
+	auto t1 = chrono::steady_clock::now();
+
+	if (quiet) {
+		double s = chrono::duration<double>(t1 - t0).count();
+		cout << count << " tokens, " << bytes << " text bytes, " << s << " s\n";
+	}
+	return 0;
+}
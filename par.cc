@@ -0,0 +1,177 @@
+// data-parallel evaluation for pmap and preduce.
+//
+// a pool of worker threads, one per core, is started on first use. each
+// worker has its own env stack, whose global scope is refreshed at the
+// start of every job from a snapshot of the bindings the function can
+// reach: the names its body references, and those of every function they
+// name in turn. a job cuts its index range into chunks and deals them round-robin
+// onto per-worker deques. workers pop their own chunks from the back and
+// steal from the front of the others' once they run dry.
+//
+// the calling thread blocks until every worker is done with the job, so
+// the function, the elements and the snapshot are never written while
+// workers read them. the functions are expected to be pure: generators
+// hold shared mutable state and are left out of the snapshot, and the
+// output builtins refuse to run on a worker.
+
+#include "zeal.hh"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+thread_local bool par_worker = false;
+
+struct Chunk {
+	size_t lo, hi, idx;
+};
+
+struct ParQueue {
+	mutex m;
+	deque<Chunk> q;
+};
+
+struct Pool {
+	vector<ParQueue> queues;
+	mutex m;
+	condition_variable wake, done;
+	uint64_t gen = 0;
+	size_t busy = 0;
+
+	// the current job
+	const Scope* env = nullptr;
+	function<void(const Chunk&)> body;
+
+	Pool(size_t n): queues(n) {
+		for (size_t i = 0; i < n; i++) thread(&Pool::run, this, i).detach();
+	}
+
+	bool take(size_t i, Chunk& c) {
+		{
+			lock_guard<mutex> l(queues[i].m);
+			if (!queues[i].q.empty()) {
+				c = queues[i].q.back();
+				queues[i].q.pop_back();
+				return true;
+			}
+		}
+		for (size_t k = 1; k < queues.size(); k++) {
+			ParQueue& v = queues[(i + k) % queues.size()];
+			lock_guard<mutex> l(v.m);
+			if (!v.q.empty()) {
+				c = v.q.front();
+				v.q.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void run(size_t i) {
+		par_worker = true;
+		jit_worker = true;
+		env_stack = new EnvStack();
+
+		uint64_t seen = 0;
+		while (true) {
+			{
+				unique_lock<mutex> l(m);
+				wake.wait(l, [&] { return gen != seen; });
+				seen = gen;
+			}
+
+			jit_forget();
+			env_stack->stack.resize(1);
+			env_stack->stack[0] = make_unique<Scope>();
+			for (auto& kv : env->scope) env_stack->create(kv.first, obj_clone(kv.second.get()));
+
+			Chunk c;
+			while (take(i, c)) body(c);
+
+			lock_guard<mutex> l(m);
+			if (--busy == 0) done.notify_one();
+		}
+	}
+
+	// runs body over [0, n) in chunks of size chunk, and waits for it.
+	// fn is the function body applies
+	void dispatch(Object* fn, size_t n, size_t chunk, function<void(const Chunk&)> f) {
+		// the innermost binding of every name fn can reach. a name that is
+		// a parameter or local somewhere may copy an unused global too
+		Scope snap;
+		unordered_set<string> names;
+		vector<Object*> work = { fn };
+		while (!work.empty()) {
+			Object* g = work.back();
+			work.pop_back();
+			if (g->otype != ObjType::FN) continue;
+			unordered_set<string> r;
+			refs_block(((Fn*)g)->body->stmt_list, r);
+			for (auto& name : r) {
+				if (!names.insert(name).second) continue;
+				Object* v = env_stack->find(name);
+				if (v == nullptr || v->otype == ObjType::GEN) continue;
+				snap.insert(name, obj_clone(v));
+				work.push_back(v);
+			}
+		}
+
+		for (size_t lo = 0, k = 0; lo < n; lo += chunk, k++)
+			queues[k % queues.size()].q.push_back({ lo, min(n, lo + chunk), k });
+
+		unique_lock<mutex> l(m);
+		env = &snap;
+		body = f;
+		busy = queues.size();
+		gen++;
+		wake.notify_all();
+		done.wait(l, [&] { return busy == 0; });
+		body = nullptr;
+		env = nullptr;
+	}
+};
+
+static Pool* pool() {
+	static Pool* p = new Pool(max(1u, thread::hardware_concurrency()));
+	return p;
+}
+
+// about 8 chunks per worker, so stealing can even out uneven elements
+// while cheap functions still get long runs between queue operations.
+// nested inside a worker, everything runs on that worker as one chunk
+static size_t par_chunk(size_t n) {
+	if (par_worker) return max<size_t>(1, n);
+	return max<size_t>(1, n / (8 * pool()->queues.size()));
+}
+
+static void par_run(Object* fn, size_t n, size_t chunk, function<void(const Chunk&)> f) {
+	if (n == 0) return;
+	if (par_worker) return f({ 0, n, 0 });
+	pool()->dispatch(fn, n, chunk, f);
+}
+
+vector<unique_ptr<Object>> par_map(Object* f, const vector<unique_ptr<Object>>& xs) {
+	vector<unique_ptr<Object>> res(xs.size());
+	par_run(f, xs.size(), par_chunk(xs.size()), [&](const Chunk& c) {
+		for (size_t i = c.lo; i < c.hi; i++) {
+			Object* argv[] = { xs[i].get() };
+			res[i] = apply(f, argv, 1);
+		}
+	});
+	return res;
+}
+
+vector<unique_ptr<Object>> par_fold(Object* f, const vector<unique_ptr<Object>>& xs) {
+	size_t n = xs.size(), chunk = par_chunk(n);
+	vector<unique_ptr<Object>> res((n + chunk - 1) / chunk);
+	par_run(f, n, chunk, [&](const Chunk& c) {
+		unique_ptr<Object> acc = obj_clone(xs[c.lo].get());
+		for (size_t i = c.lo + 1; i < c.hi; i++) {
+			Object* argv[] = { acc.get(), xs[i].get() };
+			acc = apply(f, argv, 2);
+		}
+		res[c.idx] = move(acc);
+	});
+	return res;
+}
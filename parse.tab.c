@@ -0,0 +1,1822 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "zeal.y"
+
+    #include "zeal.cc"
+    extern "C" void yyerror(const char *s);
+    extern int yylex(void);
+    extern FILE *yyin;
+    extern int yylex_errors;
+	bool repl = true;
+	Program *parsed = nullptr;
+
+#line 81 "parse.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parse.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_LET = 3,                        /* LET  */
+  YYSYMBOL_RETURN = 4,                     /* RETURN  */
+  YYSYMBOL_TRUE_VAL = 5,                   /* TRUE_VAL  */
+  YYSYMBOL_FALSE_VAL = 6,                  /* FALSE_VAL  */
+  YYSYMBOL_IF = 7,                         /* IF  */
+  YYSYMBOL_ELSE = 8,                       /* ELSE  */
+  YYSYMBOL_EQ = 9,                         /* EQ  */
+  YYSYMBOL_NE = 10,                        /* NE  */
+  YYSYMBOL_LE = 11,                        /* LE  */
+  YYSYMBOL_GE = 12,                        /* GE  */
+  YYSYMBOL_AND = 13,                       /* AND  */
+  YYSYMBOL_OR = 14,                        /* OR  */
+  YYSYMBOL_INT_VAL = 15,                   /* INT_VAL  */
+  YYSYMBOL_FLT_VAL = 16,                   /* FLT_VAL  */
+  YYSYMBOL_IDF = 17,                       /* IDF  */
+  YYSYMBOL_STR_VAL = 18,                   /* STR_VAL  */
+  YYSYMBOL_NULL_VAL = 19,                  /* NULL_VAL  */
+  YYSYMBOL_FN = 20,                        /* FN  */
+  YYSYMBOL_YIELD = 21,                     /* YIELD  */
+  YYSYMBOL_22_ = 22,                       /* '!'  */
+  YYSYMBOL_23_ = 23,                       /* '<'  */
+  YYSYMBOL_24_ = 24,                       /* '>'  */
+  YYSYMBOL_25_ = 25,                       /* '+'  */
+  YYSYMBOL_26_ = 26,                       /* '-'  */
+  YYSYMBOL_27_ = 27,                       /* '*'  */
+  YYSYMBOL_28_ = 28,                       /* '/'  */
+  YYSYMBOL_29_ = 29,                       /* '%'  */
+  YYSYMBOL_Uminus = 30,                    /* Uminus  */
+  YYSYMBOL_IFX = 31,                       /* IFX  */
+  YYSYMBOL_32_ = 32,                       /* '{'  */
+  YYSYMBOL_33_ = 33,                       /* '}'  */
+  YYSYMBOL_34_ = 34,                       /* '('  */
+  YYSYMBOL_35_ = 35,                       /* ')'  */
+  YYSYMBOL_36_ = 36,                       /* ','  */
+  YYSYMBOL_37_ = 37,                       /* '='  */
+  YYSYMBOL_38_ = 38,                       /* ';'  */
+  YYSYMBOL_YYACCEPT = 39,                  /* $accept  */
+  YYSYMBOL_program = 40,                   /* program  */
+  YYSYMBOL_stmt_list = 41,                 /* stmt_list  */
+  YYSYMBOL_block_stmt = 42,                /* block_stmt  */
+  YYSYMBOL_fn = 43,                        /* fn  */
+  YYSYMBOL_call = 44,                      /* call  */
+  YYSYMBOL_exp_list = 45,                  /* exp_list  */
+  YYSYMBOL_arg_list = 46,                  /* arg_list  */
+  YYSYMBOL_stmt = 47,                      /* stmt  */
+  YYSYMBOL_let_stmt = 48,                  /* let_stmt  */
+  YYSYMBOL_asg_stmt = 49,                  /* asg_stmt  */
+  YYSYMBOL_ret_stmt = 50,                  /* ret_stmt  */
+  YYSYMBOL_if_stmt = 51,                   /* if_stmt  */
+  YYSYMBOL_exp_stmt = 52,                  /* exp_stmt  */
+  YYSYMBOL_yield_stmt = 53,                /* yield_stmt  */
+  YYSYMBOL_exp = 54,                       /* exp  */
+  YYSYMBOL_prefix_exp = 55,                /* prefix_exp  */
+  YYSYMBOL_infix_exp = 56                  /* infix_exp  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  41
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   361
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  39
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  18
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  55
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  101
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   278
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    22,     2,     2,     2,    29,     2,     2,
+      34,    35,    27,    25,    36,    26,     2,    28,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    38,
+      23,    37,    24,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    32,     2,    33,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    30,    31
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_uint8 yyrline[] =
+{
+       0,    49,    49,    50,    54,    55,    59,    60,    64,    65,
+      69,    70,    74,    75,    79,    80,    84,    85,    86,    87,
+      88,    89,    93,    97,   101,   105,   106,   110,   114,   118,
+     119,   120,   121,   122,   123,   124,   125,   126,   127,   128,
+     129,   133,   134,   138,   139,   140,   141,   142,   143,   144,
+     145,   146,   147,   148,   149,   150
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "LET", "RETURN",
+  "TRUE_VAL", "FALSE_VAL", "IF", "ELSE", "EQ", "NE", "LE", "GE", "AND",
+  "OR", "INT_VAL", "FLT_VAL", "IDF", "STR_VAL", "NULL_VAL", "FN", "YIELD",
+  "'!'", "'<'", "'>'", "'+'", "'-'", "'*'", "'/'", "'%'", "Uminus", "IFX",
+  "'{'", "'}'", "'('", "')'", "','", "'='", "';'", "$accept", "program",
+  "stmt_list", "block_stmt", "fn", "call", "exp_list", "arg_list", "stmt",
+  "let_stmt", "asg_stmt", "ret_stmt", "if_stmt", "exp_stmt", "yield_stmt",
+  "exp", "prefix_exp", "infix_exp", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-75)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  ((Yyn) == YYTABLE_NINF)
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+      86,    -3,   225,   -75,   -75,    -8,   -75,   -75,    -9,   -75,
+     -75,     6,   225,   225,   225,   225,    56,    86,   -75,   -75,
+     -75,   -75,   -75,   -75,   -75,   -75,   -75,   126,   -75,   -75,
+      25,    29,   147,   225,   108,   225,    19,   168,   325,   -75,
+     243,   -75,   -75,   225,   225,   225,   225,   225,   225,   225,
+     225,   225,   225,   225,   225,   225,   -75,   225,   -75,   270,
+     -75,   -33,   297,   189,   -75,    32,    -6,   -75,   -75,   332,
+     332,   332,   332,   325,   304,   332,   332,    10,    10,   -75,
+     -75,   -75,   210,    32,   -75,   225,   -75,     1,   -75,    32,
+      48,   -75,    58,   297,   -75,    54,   -75,   -75,    32,   -75,
+     -75
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       3,     0,     0,    38,    39,     0,    35,    36,    34,    37,
+      40,     0,     0,     0,     0,     0,     0,     2,    32,    33,
+       5,    16,    17,    18,    19,    20,    21,     0,    29,    30,
+       0,    34,     0,     0,     0,     0,     0,     0,    42,    41,
+       0,     1,     4,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    27,     0,    24,     0,
+      11,     0,    13,     0,    15,     0,     0,    28,    31,    48,
+      49,    51,    53,    54,    55,    50,    52,    43,    44,    45,
+      46,    47,     0,     0,    10,     0,    23,     0,     9,     0,
+       0,    22,    26,    12,     7,     0,     8,    14,     0,     6,
+      25
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+     -75,   -75,   -20,   -74,   -75,   -75,   -75,   -75,   -16,   -75,
+     -75,   -75,   -75,   -75,   -75,    -2,   -75,   -75
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,    16,    17,    88,    18,    19,    61,    66,    20,    21,
+      22,    23,    24,    25,    26,    27,    28,    29
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
+{
+      32,    42,    84,    85,     1,     2,     3,     4,     5,    92,
+      37,    38,    39,    40,    30,    96,     6,     7,     8,     9,
+      10,    11,    12,    13,   100,    34,    33,    14,    35,    89,
+      90,    59,    62,    63,    94,    15,    64,    53,    54,    55,
+      36,    69,    70,    71,    72,    73,    74,    75,    76,    77,
+      78,    79,    80,    81,    65,    82,    41,     1,     2,     3,
+       4,     5,    57,    34,    87,    97,    98,    95,     0,     6,
+       7,     8,     9,    10,    11,    12,    13,     0,     0,    42,
+      14,     0,     0,    93,     0,     0,     0,    99,    15,     1,
+       2,     3,     4,     5,     0,     0,     0,     0,     0,     0,
+       0,     6,     7,     8,     9,    10,    11,    12,    13,     0,
+       0,     0,    14,     3,     4,     0,     0,     0,     0,     0,
+      15,     0,     0,     6,     7,    31,     9,    10,    11,     0,
+      13,     0,     0,     0,    14,    43,    44,    45,    46,    47,
+      48,     0,    15,    60,     0,     0,     0,     0,     0,    49,
+      50,    51,    52,    53,    54,    55,    43,    44,    45,    46,
+      47,    48,     0,     0,    56,     0,     0,     0,     0,     0,
+      49,    50,    51,    52,    53,    54,    55,    43,    44,    45,
+      46,    47,    48,     0,     0,    58,     0,     0,     0,     0,
+       0,    49,    50,    51,    52,    53,    54,    55,    43,    44,
+      45,    46,    47,    48,     0,     0,    67,     0,     0,     0,
+       0,     0,    49,    50,    51,    52,    53,    54,    55,    43,
+      44,    45,    46,    47,    48,     0,     0,    86,     0,     0,
+       3,     4,     0,    49,    50,    51,    52,    53,    54,    55,
+       6,     7,    31,     9,    10,    11,     0,    13,    91,     0,
+       0,    14,    43,    44,    45,    46,    47,    48,     0,    15,
+       0,     0,     0,     0,     0,     0,    49,    50,    51,    52,
+      53,    54,    55,     0,     0,     0,     0,     0,    68,    43,
+      44,    45,    46,    47,    48,     0,     0,     0,     0,     0,
+       0,     0,     0,    49,    50,    51,    52,    53,    54,    55,
+       0,     0,     0,     0,     0,    83,    43,    44,    45,    46,
+      47,    48,     0,    43,    44,    45,    46,    47,     0,     0,
+      49,    50,    51,    52,    53,    54,    55,    49,    50,    51,
+      52,    53,    54,    55,    43,    44,    45,    46,     0,     0,
+       0,    -1,    -1,    -1,    -1,     0,     0,     0,    49,    50,
+      51,    52,    53,    54,    55,    -1,    -1,    51,    52,    53,
+      54,    55
+};
+
+static const yytype_int8 yycheck[] =
+{
+       2,    17,    35,    36,     3,     4,     5,     6,     7,    83,
+      12,    13,    14,    15,    17,    89,    15,    16,    17,    18,
+      19,    20,    21,    22,    98,    34,    34,    26,    37,    35,
+      36,    33,    34,    35,    33,    34,    17,    27,    28,    29,
+      34,    43,    44,    45,    46,    47,    48,    49,    50,    51,
+      52,    53,    54,    55,    35,    57,     0,     3,     4,     5,
+       6,     7,    37,    34,    32,    17,     8,    87,    -1,    15,
+      16,    17,    18,    19,    20,    21,    22,    -1,    -1,    95,
+      26,    -1,    -1,    85,    -1,    -1,    -1,    33,    34,     3,
+       4,     5,     6,     7,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    15,    16,    17,    18,    19,    20,    21,    22,    -1,
+      -1,    -1,    26,     5,     6,    -1,    -1,    -1,    -1,    -1,
+      34,    -1,    -1,    15,    16,    17,    18,    19,    20,    -1,
+      22,    -1,    -1,    -1,    26,     9,    10,    11,    12,    13,
+      14,    -1,    34,    35,    -1,    -1,    -1,    -1,    -1,    23,
+      24,    25,    26,    27,    28,    29,     9,    10,    11,    12,
+      13,    14,    -1,    -1,    38,    -1,    -1,    -1,    -1,    -1,
+      23,    24,    25,    26,    27,    28,    29,     9,    10,    11,
+      12,    13,    14,    -1,    -1,    38,    -1,    -1,    -1,    -1,
+      -1,    23,    24,    25,    26,    27,    28,    29,     9,    10,
+      11,    12,    13,    14,    -1,    -1,    38,    -1,    -1,    -1,
+      -1,    -1,    23,    24,    25,    26,    27,    28,    29,     9,
+      10,    11,    12,    13,    14,    -1,    -1,    38,    -1,    -1,
+       5,     6,    -1,    23,    24,    25,    26,    27,    28,    29,
+      15,    16,    17,    18,    19,    20,    -1,    22,    38,    -1,
+      -1,    26,     9,    10,    11,    12,    13,    14,    -1,    34,
+      -1,    -1,    -1,    -1,    -1,    -1,    23,    24,    25,    26,
+      27,    28,    29,    -1,    -1,    -1,    -1,    -1,    35,     9,
+      10,    11,    12,    13,    14,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    23,    24,    25,    26,    27,    28,    29,
+      -1,    -1,    -1,    -1,    -1,    35,     9,    10,    11,    12,
+      13,    14,    -1,     9,    10,    11,    12,    13,    -1,    -1,
+      23,    24,    25,    26,    27,    28,    29,    23,    24,    25,
+      26,    27,    28,    29,     9,    10,    11,    12,    -1,    -1,
+      -1,     9,    10,    11,    12,    -1,    -1,    -1,    23,    24,
+      25,    26,    27,    28,    29,    23,    24,    25,    26,    27,
+      28,    29
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     3,     4,     5,     6,     7,    15,    16,    17,    18,
+      19,    20,    21,    22,    26,    34,    40,    41,    43,    44,
+      47,    48,    49,    50,    51,    52,    53,    54,    55,    56,
+      17,    17,    54,    34,    34,    37,    34,    54,    54,    54,
+      54,     0,    47,     9,    10,    11,    12,    13,    14,    23,
+      24,    25,    26,    27,    28,    29,    38,    37,    38,    54,
+      35,    45,    54,    54,    17,    35,    46,    38,    35,    54,
+      54,    54,    54,    54,    54,    54,    54,    54,    54,    54,
+      54,    54,    54,    35,    35,    36,    38,    32,    42,    35,
+      36,    38,    42,    54,    33,    41,    42,    17,     8,    33,
+      42
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    39,    40,    40,    41,    41,    42,    42,    43,    43,
+      44,    44,    45,    45,    46,    46,    47,    47,    47,    47,
+      47,    47,    48,    49,    50,    51,    51,    52,    53,    54,
+      54,    54,    54,    54,    54,    54,    54,    54,    54,    54,
+      54,    55,    55,    56,    56,    56,    56,    56,    56,    56,
+      56,    56,    56,    56,    56,    56
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     0,     2,     1,     3,     2,     5,     4,
+       4,     3,     3,     1,     3,     1,     1,     1,     1,     1,
+       1,     1,     5,     4,     3,     7,     5,     2,     3,     1,
+       1,     3,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     2,     2,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* program: stmt_list  */
+#line 49 "zeal.y"
+                                                                        { (yyval.prog) = new Program((yyvsp[0].stmt_wrap)); parsed = (yyval.prog); }
+#line 1237 "parse.tab.c"
+    break;
+
+  case 3: /* program: %empty  */
+#line 50 "zeal.y"
+                                                                        { (yyval.prog) = new Program(); parsed = (yyval.prog); }
+#line 1243 "parse.tab.c"
+    break;
+
+  case 4: /* stmt_list: stmt_list stmt  */
+#line 54 "zeal.y"
+                                                                { (yyvsp[-1].stmt_wrap)->push_back((yyvsp[0].st)); (yyval.stmt_wrap) = (yyvsp[-1].stmt_wrap); }
+#line 1249 "parse.tab.c"
+    break;
+
+  case 5: /* stmt_list: stmt  */
+#line 55 "zeal.y"
+                                                                        { (yyval.stmt_wrap) = new StmtWrapper((yyvsp[0].st)); }
+#line 1255 "parse.tab.c"
+    break;
+
+  case 6: /* block_stmt: '{' stmt_list '}'  */
+#line 59 "zeal.y"
+                                                                { (yyval.block) = new BlockStmt((yyvsp[-1].stmt_wrap)); }
+#line 1261 "parse.tab.c"
+    break;
+
+  case 7: /* block_stmt: '{' '}'  */
+#line 60 "zeal.y"
+                                                                        { (yyval.block) = new BlockStmt(new StmtWrapper()); }
+#line 1267 "parse.tab.c"
+    break;
+
+  case 8: /* fn: FN '(' arg_list ')' block_stmt  */
+#line 64 "zeal.y"
+                                                { (yyval.exp) = new Const((yyvsp[-2].arg), (yyvsp[0].block)); }
+#line 1273 "parse.tab.c"
+    break;
+
+  case 9: /* fn: FN '(' ')' block_stmt  */
+#line 65 "zeal.y"
+                                                        { (yyval.exp) = new Const(new ArgWrapper(), (yyvsp[0].block)); }
+#line 1279 "parse.tab.c"
+    break;
+
+  case 10: /* call: IDF '(' exp_list ')'  */
+#line 69 "zeal.y"
+                                                        { (yyval.call) = new Call(*((yyvsp[-3].name)), (yyvsp[-1].exp_wrap)); }
+#line 1285 "parse.tab.c"
+    break;
+
+  case 11: /* call: IDF '(' ')'  */
+#line 70 "zeal.y"
+                                                                { (yyval.call) = new Call(*((yyvsp[-2].name)), new ExpWrapper()); }
+#line 1291 "parse.tab.c"
+    break;
+
+  case 12: /* exp_list: exp_list ',' exp  */
+#line 74 "zeal.y"
+                                                                { (yyvsp[-2].exp_wrap)->push_back((yyvsp[0].exp)); (yyval.exp_wrap) = (yyvsp[-2].exp_wrap); }
+#line 1297 "parse.tab.c"
+    break;
+
+  case 13: /* exp_list: exp  */
+#line 75 "zeal.y"
+                                                                        { (yyval.exp_wrap) = new ExpWrapper((yyvsp[0].exp)); }
+#line 1303 "parse.tab.c"
+    break;
+
+  case 14: /* arg_list: arg_list ',' IDF  */
+#line 79 "zeal.y"
+                                                                { (yyvsp[-2].arg)->push_back((yyvsp[0].name)); (yyval.arg) = (yyvsp[-2].arg); }
+#line 1309 "parse.tab.c"
+    break;
+
+  case 15: /* arg_list: IDF  */
+#line 80 "zeal.y"
+                                                                        { (yyval.arg) = new ArgWrapper((yyvsp[0].name)); }
+#line 1315 "parse.tab.c"
+    break;
+
+  case 16: /* stmt: let_stmt  */
+#line 84 "zeal.y"
+                                                                        { (yyval.st) = (yyvsp[0].st); }
+#line 1321 "parse.tab.c"
+    break;
+
+  case 17: /* stmt: asg_stmt  */
+#line 85 "zeal.y"
+                                                                        { (yyval.st) = (yyvsp[0].st); }
+#line 1327 "parse.tab.c"
+    break;
+
+  case 18: /* stmt: ret_stmt  */
+#line 86 "zeal.y"
+                                                                        { (yyval.st) = (yyvsp[0].st); }
+#line 1333 "parse.tab.c"
+    break;
+
+  case 19: /* stmt: if_stmt  */
+#line 87 "zeal.y"
+                                                                        { (yyval.st) = (yyvsp[0].st); }
+#line 1339 "parse.tab.c"
+    break;
+
+  case 20: /* stmt: exp_stmt  */
+#line 88 "zeal.y"
+                                                                        { (yyval.st) = (yyvsp[0].st); }
+#line 1345 "parse.tab.c"
+    break;
+
+  case 21: /* stmt: yield_stmt  */
+#line 89 "zeal.y"
+                                                                { (yyval.st) = (yyvsp[0].st); }
+#line 1351 "parse.tab.c"
+    break;
+
+  case 22: /* let_stmt: LET IDF '=' exp ';'  */
+#line 93 "zeal.y"
+                                                        { (yyval.st) = new LetStmt(*((yyvsp[-3].name)), (yyvsp[-1].exp)); }
+#line 1357 "parse.tab.c"
+    break;
+
+  case 23: /* asg_stmt: IDF '=' exp ';'  */
+#line 97 "zeal.y"
+                                                                { (yyval.st) = new AsgStmt(*((yyvsp[-3].name)), (yyvsp[-1].exp)); }
+#line 1363 "parse.tab.c"
+    break;
+
+  case 24: /* ret_stmt: RETURN exp ';'  */
+#line 101 "zeal.y"
+                                                                { (yyval.st) = new RetStmt((yyvsp[-1].exp)); }
+#line 1369 "parse.tab.c"
+    break;
+
+  case 25: /* if_stmt: IF '(' exp ')' block_stmt ELSE block_stmt  */
+#line 105 "zeal.y"
+                                                                { (yyval.st) = new IfStmt((yyvsp[-4].exp), (yyvsp[-2].block), (yyvsp[0].block)); }
+#line 1375 "parse.tab.c"
+    break;
+
+  case 26: /* if_stmt: IF '(' exp ')' block_stmt  */
+#line 106 "zeal.y"
+                                                                { (yyval.st) = new IfStmt((yyvsp[-2].exp), (yyvsp[0].block), NULL); }
+#line 1381 "parse.tab.c"
+    break;
+
+  case 27: /* exp_stmt: exp ';'  */
+#line 110 "zeal.y"
+                                                                        { (yyval.st) = new ExpStmt((yyvsp[-1].exp)); }
+#line 1387 "parse.tab.c"
+    break;
+
+  case 28: /* yield_stmt: YIELD exp ';'  */
+#line 114 "zeal.y"
+                                                                { (yyval.st) = new YieldStmt((yyvsp[-1].exp)); }
+#line 1393 "parse.tab.c"
+    break;
+
+  case 29: /* exp: prefix_exp  */
+#line 118 "zeal.y"
+                                                                { (yyval.exp) = (yyvsp[0].exp); }
+#line 1399 "parse.tab.c"
+    break;
+
+  case 30: /* exp: infix_exp  */
+#line 119 "zeal.y"
+                                                                        { (yyval.exp) = (yyvsp[0].exp); }
+#line 1405 "parse.tab.c"
+    break;
+
+  case 31: /* exp: '(' exp ')'  */
+#line 120 "zeal.y"
+                                                                { (yyval.exp) = (yyvsp[-1].exp); }
+#line 1411 "parse.tab.c"
+    break;
+
+  case 32: /* exp: fn  */
+#line 121 "zeal.y"
+                                                                        { (yyval.exp) = (yyvsp[0].exp); }
+#line 1417 "parse.tab.c"
+    break;
+
+  case 33: /* exp: call  */
+#line 122 "zeal.y"
+                                                                        { (yyval.exp) = (yyvsp[0].call); }
+#line 1423 "parse.tab.c"
+    break;
+
+  case 34: /* exp: IDF  */
+#line 123 "zeal.y"
+                                                                        { (yyval.exp) = new Idf(*((yyvsp[0].name))); }
+#line 1429 "parse.tab.c"
+    break;
+
+  case 35: /* exp: INT_VAL  */
+#line 124 "zeal.y"
+                                                                        { (yyval.exp) = new Const(*((yyvsp[0].name)), ConstType::INT); }
+#line 1435 "parse.tab.c"
+    break;
+
+  case 36: /* exp: FLT_VAL  */
+#line 125 "zeal.y"
+                                                                        { (yyval.exp) = new Const(*((yyvsp[0].name)), ConstType::FLT); }
+#line 1441 "parse.tab.c"
+    break;
+
+  case 37: /* exp: STR_VAL  */
+#line 126 "zeal.y"
+                                                                        { (yyval.exp) = new Const(*((yyvsp[0].name)), ConstType::STR); }
+#line 1447 "parse.tab.c"
+    break;
+
+  case 38: /* exp: TRUE_VAL  */
+#line 127 "zeal.y"
+                                                                        { (yyval.exp) = new Const(true); }
+#line 1453 "parse.tab.c"
+    break;
+
+  case 39: /* exp: FALSE_VAL  */
+#line 128 "zeal.y"
+                                                                        { (yyval.exp) = new Const(false); }
+#line 1459 "parse.tab.c"
+    break;
+
+  case 40: /* exp: NULL_VAL  */
+#line 129 "zeal.y"
+                                                                        { (yyval.exp) = new Const(); }
+#line 1465 "parse.tab.c"
+    break;
+
+  case 41: /* prefix_exp: '-' exp  */
+#line 133 "zeal.y"
+                                                        { (yyval.exp) = new PrefixExp(PrefixOp::NEG, (yyvsp[0].exp)); }
+#line 1471 "parse.tab.c"
+    break;
+
+  case 42: /* prefix_exp: '!' exp  */
+#line 134 "zeal.y"
+                                                                        { (yyval.exp) = new PrefixExp(PrefixOp::NOT, (yyvsp[0].exp)); }
+#line 1477 "parse.tab.c"
+    break;
+
+  case 43: /* infix_exp: exp '+' exp  */
+#line 138 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::ADD, (yyvsp[0].exp)); }
+#line 1483 "parse.tab.c"
+    break;
+
+  case 44: /* infix_exp: exp '-' exp  */
+#line 139 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::SUB, (yyvsp[0].exp)); }
+#line 1489 "parse.tab.c"
+    break;
+
+  case 45: /* infix_exp: exp '*' exp  */
+#line 140 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::MUL, (yyvsp[0].exp)); }
+#line 1495 "parse.tab.c"
+    break;
+
+  case 46: /* infix_exp: exp '/' exp  */
+#line 141 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::DIV, (yyvsp[0].exp)); }
+#line 1501 "parse.tab.c"
+    break;
+
+  case 47: /* infix_exp: exp '%' exp  */
+#line 142 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::MOD, (yyvsp[0].exp)); }
+#line 1507 "parse.tab.c"
+    break;
+
+  case 48: /* infix_exp: exp EQ exp  */
+#line 143 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::EQ, (yyvsp[0].exp)); }
+#line 1513 "parse.tab.c"
+    break;
+
+  case 49: /* infix_exp: exp NE exp  */
+#line 144 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::NE, (yyvsp[0].exp)); }
+#line 1519 "parse.tab.c"
+    break;
+
+  case 50: /* infix_exp: exp '<' exp  */
+#line 145 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::LT, (yyvsp[0].exp)); }
+#line 1525 "parse.tab.c"
+    break;
+
+  case 51: /* infix_exp: exp LE exp  */
+#line 146 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::LE, (yyvsp[0].exp)); }
+#line 1531 "parse.tab.c"
+    break;
+
+  case 52: /* infix_exp: exp '>' exp  */
+#line 147 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::GT, (yyvsp[0].exp)); }
+#line 1537 "parse.tab.c"
+    break;
+
+  case 53: /* infix_exp: exp GE exp  */
+#line 148 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::GE, (yyvsp[0].exp)); }
+#line 1543 "parse.tab.c"
+    break;
+
+  case 54: /* infix_exp: exp AND exp  */
+#line 149 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::AND, (yyvsp[0].exp)); }
+#line 1549 "parse.tab.c"
+    break;
+
+  case 55: /* infix_exp: exp OR exp  */
+#line 150 "zeal.y"
+                                                                { (yyval.exp) = new InfixExp((yyvsp[-2].exp), InfixOp::OR, (yyvsp[0].exp)); }
+#line 1555 "parse.tab.c"
+    break;
+
+
+#line 1559 "parse.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 153 "zeal.y"
+
+
+static int parse_opt (int key, char *arg, struct argp_state *state);
+
+static string snapshot_path, image_path, script_path;
+static bool watch_mode = false;
+
+int main (int argc, char **argv) {
+	struct argp_option options[] = {
+		{ 0, 'i', 0, 0, "Interpret the input and print result"},
+		{ "no-jit", 'n', 0, 0, "Never compile functions to native code"},
+		{ "jit-always", 'j', 0, 0, "Compile every eligible function on its first call"},
+		{ "snapshot", 's', "IMAGE", 0, "Write the globals left by the input to IMAGE"},
+		{ "image", 'm', "IMAGE", 0, "Start with the globals saved in IMAGE"},
+		{ "watch", 'w', 0, 0, "Rerun FILE whenever it changes, reusing results of unaffected statements"},
+		{ 0 }
+	};
+
+	struct argp argp = { options, parse_opt, "[FILE]" };
+	argp_parse (&argp, argc, argv, 0, 0, 0);
+
+	init();
+	if (!image_path.empty()) {
+		string err = image_load(image_path);
+		if (!err.empty()) {
+			cerr << "[error] " << err << endl;
+			return 1;
+		}
+	}
+
+	if (watch_mode) {
+		if (script_path.empty()) {
+			cerr << "[error] --watch needs a FILE" << endl;
+			return 1;
+		}
+		return watch(script_path);
+	}
+
+	// the program only runs once it has been parsed in full, and not at
+	// all if the scanner had to skip anything
+	int r = yyparse();
+	if (r == 0 && yylex_errors > 0) r = 1;
+	if (r == 0) parsed->code();
+	if (r == 0 && !snapshot_path.empty()) {
+		string err = image_save(snapshot_path);
+		if (!err.empty()) {
+			cerr << "[error] " << err << endl;
+			return 1;
+		}
+	}
+	return r;
+}
+
+
+static int parse_opt (int key, char *arg, struct argp_state *state) {
+	switch (key) {
+		case 'i': repl = true; break;
+		case 'n': jit_enabled = false; break;
+		case 'j': jit_threshold = 0; break;
+		case 's': snapshot_path = arg; break;
+		case 'm': image_path = arg; break;
+		case 'w': watch_mode = true; break;
+		case ARGP_KEY_ARG:
+			if (state->arg_num > 0) argp_usage(state);
+			script_path = arg;
+			yyin = fopen(arg, "r");
+			if (yyin == nullptr) argp_failure(state, 1, errno, "%s", arg);
+			break;
+	}
+	return 0;
+}
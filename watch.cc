@@ -0,0 +1,444 @@
+// watch mode: `zeal --watch FILE` keeps the interpreter resident and
+// reruns FILE every time it changes, redoing as little as it can.
+//
+// the source is cut into top-level statements by a light scan of its
+// text (brackets, strings and comments only). each statement is cached by
+// its text along with its AST, the names it references, the output it
+// printed and the global bindings it left, as recorded by the env stack's
+// log. on a change, every run of new or edited statements is parsed as
+// one region, and the program is replayed in order. a cached statement
+// restores its bindings and output, and only runs again if it references
+// a name changed before it. the global scope is kept between runs along
+// with what each binding replaced, and is only wound back as far as the
+// first statement that runs again. a name changes where a statement that
+// ran again binds it, and where the statement that bound it was removed
+// or moved. a statement after that which references it changes what it
+// binds in turn, and so, since functions look globals up when called, does
+// a function bound before it.
+//
+// statements that use the file builtins or leave a generator behind run
+// every time, as their results do not follow from the source alone.
+
+#include "zeal.hh"
+#include "parse.tab.h"
+#include <algorithm>
+#include <chrono>
+
+extern Program* parsed;
+extern int yylex_errors;
+void yyrestart(FILE* f);
+
+// how often the file is checked for changes
+const useconds_t WATCH_POLL_US = 20000;
+
+static const char* WATCH_IMPURE[] = { "read_file", "read_lines", "write_file" };
+
+struct WatchStmt {
+	string text;
+	uint64_t hash = 0;
+	StmtWrapper* stmts = nullptr;
+	unordered_set<string> refs;
+
+	// place in the program, from 1, and the run that last matched it
+	size_t pos = 0;
+	unsigned seen = 0;
+
+	// results of the last run
+	bool ran = false;
+	bool always = false;
+	vector<pair<string, unique_ptr<Object>>> effect;
+	string output;
+};
+
+// the names a statement reads. those its top-level lets and assignments
+// bind are left out unless read as well, as its own result is not an input
+static void read_refs(StmtWrapper* b, unordered_set<string>& r) {
+	for (auto s : b->stmts) {
+		if (s->stype == StmtType::LET) refs_exp(((LetStmt*)s)->rhs, r);
+		else if (s->stype == StmtType::ASG) refs_exp(((AsgStmt*)s)->rhs, r);
+		else refs_stmt(s, r);
+	}
+}
+
+// FNV-1a, so statements can be looked up without copying their text
+static uint64_t text_hash(const char* p, size_t n) {
+	uint64_t h = 14695981039346656037ull;
+	for (size_t i = 0; i < n; i++) h = (h ^ (unsigned char)p[i]) * 1099511628211ull;
+	return h;
+}
+
+// --------------------------------
+// splitting the source into top-level statements
+
+struct Span {
+	size_t lo, hi;
+};
+
+static bool at_comment(const string& src, size_t i) {
+	return src[i] == '/' && i + 1 < src.size() && src[i + 1] == '/';
+}
+
+// whitespace and comments from i on
+static size_t skip_blank(const string& src, size_t i) {
+	while (i < src.size()) {
+		if (isspace((unsigned char)src[i])) i++;
+		else if (at_comment(src, i)) {
+			i = src.find('\n', i);
+			if (i == string::npos) i = src.size();
+		} else break;
+	}
+	return i;
+}
+
+static bool at_word(const string& src, size_t i, const char* w) {
+	size_t n = strlen(w);
+	if (src.compare(i, n, w) != 0) return false;
+	return i + n == src.size() || !(isalnum((unsigned char)src[i + n]) || src[i + n] == '_');
+}
+
+// a statement ends at a ';' outside any bracket, or, for an if
+// statement, at its closing '}' when no else follows
+static vector<Span> split(const string& src) {
+	vector<Span> v;
+	size_t n = src.size(), i = skip_blank(src, 0), lo = i;
+	int depth = 0;
+
+	while (i < n) {
+		char c = src[i];
+		if (c == '"') {
+			i = src.find('"', i + 1);
+			i = i == string::npos ? n : i + 1;
+			continue;
+		}
+		if (at_comment(src, i)) {
+			i = skip_blank(src, i);
+			continue;
+		}
+
+		i++;
+		if (c == '(' || c == '{') depth++;
+		else if (c == ')' || c == '}') depth--;
+		if (depth > 0) continue;
+
+		bool if_end = c == '}' && at_word(src, lo, "if") && !at_word(src, skip_blank(src, i), "else");
+		if (c == ';' || if_end || depth < 0) {
+			v.push_back({ lo, i });
+			i = lo = skip_blank(src, i);
+			depth = 0;
+		}
+	}
+	if (lo < n) v.push_back({ lo, n });
+	return v;
+}
+
+// the statements in src[lo, hi), which starts on line `line`, or nullptr
+// after a syntax error or unknown input
+static StmtWrapper* parse(const string& src, size_t lo, size_t hi, size_t line) {
+	// leading newlines keep line numbers in messages in step with the file
+	string text(line - 1, '\n');
+	text.append(src, lo, hi - lo);
+
+	FILE* f = fmemopen((void*)text.data(), text.size(), "r");
+	if (f == nullptr) return nullptr;
+	yyrestart(f);
+	yylex_errors = 0;
+	parsed = nullptr;
+	int r = yyparse();
+	fclose(f);
+	if (r == 0 && yylex_errors > 0) {
+		// never run, so nothing can have been compiled from it
+		delete parsed;
+		parsed = nullptr;
+	}
+	if (r != 0 || parsed == nullptr) return nullptr;
+
+	StmtWrapper* s = parsed->stmt_list != nullptr ? parsed->stmt_list : new StmtWrapper();
+	parsed->stmt_list = nullptr;
+	delete parsed;
+	parsed = nullptr;
+	return s;
+}
+
+// --------------------------------
+
+// a statement whose bindings are in the global scope, with the values
+// they replaced
+struct Applied {
+	WatchStmt* s;
+	vector<pair<string, unique_ptr<Object>>> undo;
+};
+
+struct Watcher {
+	string path;
+	vector<unique_ptr<WatchStmt>> prog;
+	unsigned runs = 0;
+
+	// kept across runs and updated as statements come and go, so a run
+	// costs little more than a scan of the source when little changed
+	unordered_map<uint64_t, vector<WatchStmt*>> by_hash;
+	unordered_map<string, unordered_set<WatchStmt*>> users;
+
+	// the global scope is what init() bound plus what these bound, in
+	// order. they are always a prefix of prog
+	vector<Applied> applied;
+
+	// each changed name with the earliest place it changed, the position
+	// of the statement after which it differs
+	unordered_map<string, size_t> changed;
+	unordered_set<WatchStmt*> dirty;
+
+	// name, changed after position from, and what that changes in turn.
+	// statements after from that reference it run again. those up to from
+	// do not, but functions they bound see the change when called later
+	void mark(const string& name, size_t from) {
+		vector<pair<string, size_t>> work = { { name, from } };
+		while (!work.empty()) {
+			string n = work.back().first;
+			size_t at = work.back().second;
+			work.pop_back();
+			auto c = changed.find(n);
+			if (c != changed.end() && c->second <= at) continue;
+			changed[n] = at;
+			auto it = users.find(n);
+			if (it == users.end()) continue;
+			for (auto s : it->second) {
+				if (s->pos > at) {
+					dirty.insert(s);
+					for (auto& e : s->effect) work.push_back({ e.first, s->pos });
+				} else {
+					for (auto& e : s->effect)
+						if (e.second->otype == ObjType::FN) work.push_back({ e.first, at });
+				}
+			}
+		}
+	}
+
+	void add(WatchStmt* s) {
+		by_hash[s->hash].push_back(s);
+		for (auto& r : s->refs) users[r].insert(s);
+	}
+
+	void remove(WatchStmt* s) {
+		auto& v = by_hash[s->hash];
+		v.erase(find(v.begin(), v.end(), s));
+		if (v.empty()) by_hash.erase(s->hash);
+		for (auto& r : s->refs) {
+			auto it = users.find(r);
+			it->second.erase(s);
+			if (it->second.empty()) users.erase(it);
+		}
+	}
+
+	// the first cached statement with this text placed after `after` and
+	// not taken yet in this run
+	WatchStmt* match(const string& src, const Span& sp, uint64_t h, size_t after) {
+		auto it = by_hash.find(h);
+		if (it == by_hash.end()) return nullptr;
+		WatchStmt* best = nullptr;
+		for (auto s : it->second) {
+			if (s->seen == runs || s->pos <= after || (best != nullptr && s->pos > best->pos)) continue;
+			if (s->text.compare(0, string::npos, src, sp.lo, sp.hi - sp.lo) == 0) best = s;
+		}
+		return best;
+	}
+
+	// undoes applied statements until n are left
+	void rollback(size_t n) {
+		auto& scope = env_stack->stack[0]->scope;
+		for (; applied.size() > n; applied.pop_back()) {
+			auto& undo = applied.back().undo;
+			for (auto it = undo.rbegin(); it != undo.rend(); ++it) {
+				if (it->second == nullptr) scope.erase(it->first);
+				else scope[it->first] = move(it->second);
+			}
+		}
+	}
+
+	// binds what s bound when it last ran
+	void restore(WatchStmt* s) {
+		auto& scope = env_stack->stack[0]->scope;
+		applied.push_back({ s, {} });
+		for (auto& e : s->effect) {
+			auto& slot = scope[e.first];
+			applied.back().undo.push_back({ e.first, move(slot) });
+			slot = obj_clone(e.second.get());
+		}
+	}
+
+	void exec(WatchStmt* s) {
+		vector<pair<string, unique_ptr<Object>>> log;
+		string output;
+
+		out.flush();
+		out.capture = &output;
+		env_stack->log = &log;
+		for (auto st : s->stmts->stmts) st->code();
+		out.flush();
+		out.capture = nullptr;
+		env_stack->log = nullptr;
+
+		// a failed call can leave its scope behind
+		env_stack->stack.resize(1);
+
+		vector<string> names;
+		for (auto& l : log) names.push_back(l.first);
+		sort(names.begin(), names.end());
+		names.erase(unique(names.begin(), names.end()), names.end());
+
+		s->ran = true;
+		s->always = false;
+		s->effect.clear();
+		for (auto& name : names) {
+			auto it = env_stack->stack[0]->scope.find(name);
+			if (it == env_stack->stack[0]->scope.end()) continue;
+			if (it->second->otype == ObjType::GEN) s->always = true;
+			s->effect.push_back({ name, obj_clone(it->second.get()) });
+		}
+		for (auto name : WATCH_IMPURE)
+			if (s->refs.count(name)) s->always = true;
+		s->output = move(output);
+		out.write(s->output);
+		applied.push_back({ s, move(log) });
+	}
+
+	void run() {
+		string src, err = read_all(path, src);
+		if (!err.empty()) {
+			cerr << "[error] " << err << endl;
+			return;
+		}
+		auto t0 = chrono::steady_clock::now();
+
+		// cached statements are reused while their text comes in the same
+		// order. one that turns up earlier than another counts as moved
+		runs++;
+		vector<Span> spans = split(src);
+		vector<WatchStmt*> next(spans.size());
+		vector<unique_ptr<WatchStmt>> made;
+		size_t last = 0;
+		for (size_t i = 0; i < spans.size(); i++) {
+			const char* p = src.data() + spans[i].lo;
+			size_t n = spans[i].hi - spans[i].lo;
+			uint64_t h = text_hash(p, n);
+			WatchStmt* s = match(src, spans[i], h, last);
+			if (s != nullptr) {
+				s->seen = runs;
+				last = s->pos;
+				next[i] = s;
+				continue;
+			}
+			made.push_back(make_unique<WatchStmt>());
+			made.back()->text.assign(p, n);
+			made.back()->hash = h;
+			next[i] = made.back().get();
+		}
+
+		// parse each run of new statements as one region
+		size_t line = 1, at = 0;
+		for (size_t a = 0; a < spans.size(); a++) {
+			if (next[a]->stmts != nullptr) continue;
+			size_t b = a;
+			while (b < spans.size() && next[b]->stmts == nullptr) b++;
+
+			line += count(src.begin() + at, src.begin() + spans[a].lo, '\n');
+			at = spans[a].lo;
+			StmtWrapper* region = parse(src, spans[a].lo, spans[b - 1].hi, line);
+			if (region == nullptr) return;
+
+			if (region->stmts.size() == b - a) {
+				for (size_t i = a; i < b; i++) next[i]->stmts = new StmtWrapper(region->stmts[i - a]);
+				region->stmts.clear();
+				delete region;
+			} else {
+				// the text scan cut the region differently from the parser,
+				// so it is kept as a single statement
+				next[a]->text = src.substr(spans[a].lo, spans[b - 1].hi - spans[a].lo);
+				next[a]->hash = text_hash(next[a]->text.data(), next[a]->text.size());
+				next[a]->stmts = region;
+				for (size_t i = a + 1; i < b; i++) next[i] = nullptr;
+			}
+			for (size_t i = a; i < b; i++)
+				if (next[i] != nullptr) read_refs(next[i]->stmts, next[i]->refs);
+			a = b - 1;
+		}
+		next.erase(std::remove(next.begin(), next.end(), nullptr), next.end());
+
+		// wound back to what the new program starts with, before removed
+		// statements are freed and their addresses can come back
+		size_t keep = 0;
+		while (keep < applied.size() && keep < next.size() && applied[keep].s == next[keep]) keep++;
+		rollback(keep);
+
+		// whatever removed or moved statements bound changes from the
+		// statement kept before them. their ASTs are not freed: the JIT
+		// keys compiled code by body address, which must not be handed out
+		// again
+		for (size_t i = 0; i < next.size(); i++) next[i]->pos = i + 1;
+		changed.clear();
+		dirty.clear();
+		vector<pair<unique_ptr<WatchStmt>, size_t>> old;
+		size_t from = 0;
+		for (auto& s : prog) {
+			if (s->seen == runs) {
+				from = s->pos;
+				s.release();
+			} else {
+				remove(s.get());
+				old.push_back({ move(s), from });
+			}
+		}
+		for (auto& s : made) add(s.release());
+		for (auto& s : old)
+			for (auto& e : s.first->effect) mark(e.first, s.second);
+
+		prog.clear();
+		for (auto s : next) prog.emplace_back(s);
+
+		// the global scope only has to be right where a statement runs, so
+		// it is moved there from wherever the last one left it
+		size_t ran = 0;
+		for (size_t i = 0; i < prog.size(); i++) {
+			WatchStmt* s = prog[i].get();
+			if (s->ran && !s->always && !dirty.count(s)) {
+				out.write(s->output);
+				continue;
+			}
+
+			rollback(i);
+			while (applied.size() < i) restore(prog[applied.size()].get());
+
+			ran++;
+			for (auto& e : s->effect) mark(e.first, s->pos);
+			exec(s);
+			for (auto& e : s->effect) mark(e.first, s->pos);
+		}
+		out.flush();
+
+		double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+		char msg[128];
+		snprintf(msg, sizeof(msg), "[watch] %zu of %zu statements run in %.3f ms", ran, prog.size(), ms);
+		cerr << msg << endl;
+	}
+};
+
+int watch(const string& path) {
+	struct stat last;
+	if (stat(path.c_str(), &last) != 0) {
+		cerr << "[error] " << path << ": " << strerror(errno) << endl;
+		return 1;
+	}
+
+	Watcher w;
+	w.path = path;
+	w.run();
+
+	while (true) {
+		usleep(WATCH_POLL_US);
+		struct stat st;
+		if (stat(path.c_str(), &st) != 0) continue;
+		if (st.st_mtim.tv_sec == last.st_mtim.tv_sec && st.st_mtim.tv_nsec == last.st_mtim.tv_nsec
+			&& st.st_size == last.st_size && st.st_ino == last.st_ino) continue;
+		last = st;
+		w.run();
+	}
+}
@@ -1,11 +1,29 @@
 #include "zeal.hh"
 
-EnvStack *env_stack;
+thread_local EnvStack *env_stack;
+Out out;
 
 void init() {
+	out.line = isatty(1);
+	atexit([] { out.flush(); });
+
 	env_stack = new EnvStack();
-	env_stack->create("len", make_unique<Len>());
-	env_stack->create("type", make_unique<Type>());
+	def("len", bf_len);
+	def("type", bf_type);
+	def("print", bf_print);
+	def("puts", bf_puts);
+	def("flush", bf_flush);
+	def("range", bf_range);
+	def("map", bf_map);
+	def("filter", bf_filter);
+	def("take", bf_take);
+	def("next", bf_next);
+	def("reduce", bf_reduce);
+	def("read_file", bf_read_file);
+	def("read_lines", bf_read_lines);
+	def("write_file", bf_write_file);
+	def("pmap", bf_pmap);
+	def("preduce", bf_preduce);
 }
 
 // --------------------------------
@@ -21,6 +39,8 @@ unordered_map<ObjType,string> objtype_str = {
 	{ ObjType::BF, "obj::builtin" },
 	{ ObjType::LIST, "obj::list" },
 	{ ObjType::DICT, "obj::dict" },
+	{ ObjType::BIG, "obj::int" },
+	{ ObjType::GEN, "obj::generator" },
 };
 
 unordered_map<PrefixOp,string> prefix_str = {
@@ -46,29 +66,69 @@ unordered_map<InfixOp,string> infix_str = {
 
 // --------------------------------
 
-void repl_print(const string& s) {
-	if (!repl) return;
-	cout << ">> " << s << endl;
+void refs_stmt(Statement* s, unordered_set<string>& r) {
+	switch (s->stype) {
+		case StmtType::LET: r.insert(((LetStmt*)s)->id); refs_exp(((LetStmt*)s)->rhs, r); break;
+		case StmtType::ASG: r.insert(((AsgStmt*)s)->id); refs_exp(((AsgStmt*)s)->rhs, r); break;
+		case StmtType::RETURN: refs_exp(((RetStmt*)s)->value, r); break;
+		case StmtType::EXP: refs_exp(((ExpStmt*)s)->value, r); break;
+		case StmtType::YIELD: refs_exp(((YieldStmt*)s)->value, r); break;
+		case StmtType::IF: {
+			IfStmt* f = (IfStmt*)s;
+			refs_exp(f->cond, r);
+			refs_block(f->then->stmt_list, r);
+			if (f->els != nullptr) refs_block(f->els->stmt_list, r);
+			break;
+		}
+	}
+}
+
+void refs_block(StmtWrapper* b, unordered_set<string>& r) {
+	for (auto s : b->stmts) refs_stmt(s, r);
+}
+
+void refs_exp(Expression* e, unordered_set<string>& r) {
+	switch (e->etype) {
+		case ExpType::CONST: {
+			Const* c = (Const*)e;
+			if (c->ctype == ConstType::FN) refs_block(((Fn*)c->cv.get())->body->stmt_list, r);
+			break;
+		}
+		case ExpType::ID: r.insert(((Idf*)e)->name); break;
+		case ExpType::PREFIX: refs_exp(((PrefixExp*)e)->right, r); break;
+		case ExpType::INFIX: refs_exp(((InfixExp*)e)->left, r); refs_exp(((InfixExp*)e)->right, r); break;
+		case ExpType::CALL: {
+			Call* c = (Call*)e;
+			r.insert(c->id);
+			for (auto a : c->args->exps) refs_exp(a, r);
+			break;
+		}
+	}
+}
+
+// --------------------------------
+
+// null results are not echoed, so calls like print(x); only show their output.
+// neither is anything on a pmap/preduce worker, which must not write to out
+void repl_print(Object* v) {
+	if (!repl || par_worker || v->otype == ObjType::NONE) return;
+	out.write(">> ", 3);
+	v->put(out);
+	out.newline();
 }
 
 unique_ptr<Object> obj_clone(Object* obj) {
 	switch (obj->otype) {
-		case ObjType::INT: return move(make_unique<Int>(obj_vcast<int>(obj)));
+		case ObjType::INT: return move(make_unique<Int>(obj_vcast<int64_t>(obj)));
+		case ObjType::BIG: return move(make_unique<BigInt>(obj_vcast<Big>(obj)));
 		case ObjType::FLT: return move(make_unique<Double>(obj_vcast<double>(obj)));
 		case ObjType::STR: return move(make_unique<String>(obj_vcast<string>(obj)));
 		case ObjType::BOOL: return move(make_unique<Bool>(obj_vcast<bool>(obj)));
 		case ObjType::NONE: return move(make_unique<Null>());
 		case ObjType::ERR: return move(make_unique<Error>(((Error*)obj)->err_type, obj_vcast<string>(obj)));
 		case ObjType::FN: return move(make_unique<Fn>(((Fn*)obj)->params, ((Fn*)obj)->body));
-		case ObjType::BF: {
-			switch (((BuiltIn*)obj)->btype) {
-				case BfType::LEN: return move(make_unique<Len>());
-				case BfType::TYPE: return move(make_unique<Type>());
-				default: 
-					cerr << "[error] Object* obj_clone(Object* obj) { ObjType::BF }";
-					exit(1);
-			}
-		}
+		case ObjType::BF: return move(make_unique<BuiltIn>(*(BuiltIn*)obj));
+		case ObjType::GEN: return move(make_unique<Gen>(((Gen*)obj)->state));
 		default: 
 			cerr << "[error] Object* obj_clone(Object* obj)";
 			exit(1);
@@ -2,4 +2,6 @@
 #include "headers/obj.hh"
 #include "headers/node.hh"
 #include "headers/scope.hh"
-#include "headers/bf.hh"
\ No newline at end of file
+#include "headers/bf.hh"
+#include "headers/image.hh"
+#include "headers/watch.hh"
\ No newline at end of file
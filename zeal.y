@@ -2,7 +2,10 @@
     #include "zeal.cc"
     extern "C" void yyerror(const char *s);
     extern int yylex(void);
+    extern FILE *yyin;
+    extern int yylex_errors;
 	bool repl = true;
+	Program *parsed = nullptr;
 %}
 
 %union{
@@ -17,22 +20,21 @@
 	ExpWrapper *exp_wrap;
 }
 
-%token LET RETURN TRUE_VAL FALSE_VAL IF ELSE EQ NE LE GE AND OR INT_VAL FLT_VAL IDF STR_VAL NULL_VAL FN
+%token LET RETURN TRUE_VAL FALSE_VAL IF ELSE EQ NE LE GE AND OR INT_VAL FLT_VAL IDF STR_VAL NULL_VAL FN YIELD
 
 %left OR
 %left AND
 %right '!'
 %nonassoc LE GE '<' '>' EQ NE
 %left '+' '-'
-%left '*' '/'
+%left '*' '/' '%'
 %right Uminus
-%right '%'
 %nonassoc IFX
 %nonassoc ELSE
 
 %type <prog> program
 %type <stmt_wrap> stmt_list
-%type <st> stmt let_stmt asg_stmt ret_stmt if_stmt exp_stmt
+%type <st> stmt let_stmt asg_stmt ret_stmt if_stmt exp_stmt yield_stmt
 %type <exp> exp prefix_exp infix_exp fn
 %type <name> INT_VAL FLT_VAL IDF STR_VAL
 %type <block> block_stmt
@@ -44,8 +46,8 @@
 %%
 
 program
-	: stmt_list							{ $$ = new Program($1); $$->code(); }
-	| %empty							{ $$ = new Program(); }
+	: stmt_list							{ $$ = new Program($1); parsed = $$; }
+	| %empty							{ $$ = new Program(); parsed = $$; }
 ;
 
 stmt_list
@@ -84,6 +86,7 @@ stmt
 	| ret_stmt							{ $$ = $1; }
 	| if_stmt							{ $$ = $1; }
 	| exp_stmt							{ $$ = $1; }
+	| yield_stmt						{ $$ = $1; }
 ;
 
 let_stmt
@@ -107,6 +110,10 @@ exp_stmt
 	: exp ';'							{ $$ = new ExpStmt($1); }
 ;
 
+yield_stmt
+	: YIELD exp ';'						{ $$ = new YieldStmt($2); }
+;
+
 exp
 	: prefix_exp						{ $$ = $1; }
 	| infix_exp							{ $$ = $1; }
@@ -147,21 +154,70 @@ infix_exp
 
 static int parse_opt (int key, char *arg, struct argp_state *state);
 
+static string snapshot_path, image_path, script_path;
+static bool watch_mode = false;
+
 int main (int argc, char **argv) {
 	struct argp_option options[] = {
 		{ 0, 'i', 0, 0, "Interpret the input and print result"},
+		{ "no-jit", 'n', 0, 0, "Never compile functions to native code"},
+		{ "jit-always", 'j', 0, 0, "Compile every eligible function on its first call"},
+		{ "snapshot", 's', "IMAGE", 0, "Write the globals left by the input to IMAGE"},
+		{ "image", 'm', "IMAGE", 0, "Start with the globals saved in IMAGE"},
+		{ "watch", 'w', 0, 0, "Rerun FILE whenever it changes, reusing results of unaffected statements"},
 		{ 0 }
 	};
 
-	struct argp argp = { options, parse_opt };
+	struct argp argp = { options, parse_opt, "[FILE]" };
 	argp_parse (&argp, argc, argv, 0, 0, 0);
 
 	init();
-	return yyparse();
+	if (!image_path.empty()) {
+		string err = image_load(image_path);
+		if (!err.empty()) {
+			cerr << "[error] " << err << endl;
+			return 1;
+		}
+	}
+
+	if (watch_mode) {
+		if (script_path.empty()) {
+			cerr << "[error] --watch needs a FILE" << endl;
+			return 1;
+		}
+		return watch(script_path);
+	}
+
+	// the program only runs once it has been parsed in full, and not at
+	// all if the scanner had to skip anything
+	int r = yyparse();
+	if (r == 0 && yylex_errors > 0) r = 1;
+	if (r == 0) parsed->code();
+	if (r == 0 && !snapshot_path.empty()) {
+		string err = image_save(snapshot_path);
+		if (!err.empty()) {
+			cerr << "[error] " << err << endl;
+			return 1;
+		}
+	}
+	return r;
 }
 
 
 static int parse_opt (int key, char *arg, struct argp_state *state) {
-	if (key == 'i') repl = true; // [TODO] add more options
+	switch (key) {
+		case 'i': repl = true; break;
+		case 'n': jit_enabled = false; break;
+		case 'j': jit_threshold = 0; break;
+		case 's': snapshot_path = arg; break;
+		case 'm': image_path = arg; break;
+		case 'w': watch_mode = true; break;
+		case ARGP_KEY_ARG:
+			if (state->arg_num > 0) argp_usage(state);
+			script_path = arg;
+			yyin = fopen(arg, "r");
+			if (yyin == nullptr) argp_failure(state, 1, errno, "%s", arg);
+			break;
+	}
 	return 0;
-}
\ No newline at end of file
+}